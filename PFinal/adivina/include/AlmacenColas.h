@@ -0,0 +1,101 @@
+#ifndef __AlmacenColas_h__
+#define __AlmacenColas_h__
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+
+/**
+ * @file AlmacenColas.h
+ * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+ * @date 24/01/2017
+ * @brief Fichero cabecera del TDA AlmacenColas: cadenas guardadas en un
+ *        unico almacen en el que las que acaban igual comparten el final
+ */
+
+
+class AlmacenColas {
+
+/**
+ * @page T.D.A. AlmacenColas
+ *
+ * @section esAlmacenColas Conjunto Especificacion
+ * Una instancia \e a del tipo de dato abstracto AlmacenColas guarda una
+ * secuencia de cadenas c0, c1, ..., cn-1 en una sola cadena, el almacen, y
+ * da de cada una solo su posicion y su longitud en el. Una cadena que es el
+ * final (la cola) de otra no ocupa nada: se toma del final de la otra. Asi
+ * "que ciento volando" se guarda una vez aunque acabe muchos refranes, y las
+ * cadenas repetidas se guardan una sola vez.
+ *
+ * @section invAlmacenColas Invariante de la representación
+ *
+ *  - almacen.substr(inicio[k], longitud[k]) == ck
+ *  - Cada cadena que no es cola de ninguna otra aparece en el almacen una
+ *    sola vez, y el almacen no contiene nada mas
+ *
+ * @section faAlmacenColas Función de abstracción
+ *
+ *  fa(rep) = { almacen.substr(inicio[k], longitud[k]) : 0 <= k < n }
+ */
+
+private:
+
+  string almacen;             /**< Cadenas que no son cola de otra, seguidas */
+  vector<unsigned> inicio;    /**< Posicion de cada cadena en almacen */
+  vector<unsigned> longitud;  /**< Longitud de cada cadena */
+
+public:
+
+  /**
+   * @brief Construye el almacen de una secuencia de cadenas
+   * @param cadenas : cadenas a guardar. Se identifican por su posicion
+   * @note Ordena las cadenas leidas de derecha a izquierda, de forma que cada
+   *       una queda justo antes de las que acaban como ella: O(N log n) para
+   *       n cadenas de N caracteres
+   */
+  void Construye(const vector<string> &cadenas);
+
+  /**
+   * @brief Vacia el almacen
+   */
+  void clear();
+
+  /**
+   * @brief Posicion de la cadena k en el almacen
+   * @pre 0 <= k < size()
+   */
+  unsigned Inicio(int k) const { return inicio[k]; }
+
+  /**
+   * @brief Longitud de la cadena k
+   * @pre 0 <= k < size()
+   */
+  unsigned Longitud(int k) const { return longitud[k]; }
+
+  /**
+   * @brief Copia de la cadena k
+   * @pre 0 <= k < size()
+   */
+  string Cadena(int k) const { return almacen.substr(inicio[k], longitud[k]); }
+
+  /**
+   * @brief Almacen con todas las cadenas
+   */
+  const string & Almacen() const { return almacen; }
+
+  /**
+   * @brief Numero de cadenas guardadas
+   */
+  int size() const { return inicio.size(); }
+
+  /**
+   * @brief Numero de caracteres del almacen
+   * @note Es la suma de las longitudes de las cadenas menos lo que ahorran
+   *       las colas compartidas
+   */
+  int Caracteres() const { return almacen.size(); }
+};
+
+#endif
@@ -0,0 +1,82 @@
+ /**
+  * @file AnotacionesNodo.cpp
+  * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+  * @date 14 de Diciembre de 2016, 14:52
+  * @brief Fichero implementacion de las politicas de anotacion de nodos
+  *
+  */
+
+
+
+/***************************** CON ANOTACIONES ******************************/
+
+
+
+template <class N>
+void ConAnotaciones<N> :: Recalcular ( N* r ) {
+
+	N *x = r;
+	x->profundidad = x->padre != 0 ? x->padre->profundidad + 1 : 0;
+
+	// Recorrido por los enlaces: la profundidad se fija al bajar y el 
+	// tamaño al subir, cuando ya están calculados todos los hijos
+	while ( true ) {
+		while ( x->izqda != 0 ) {
+			x = x->izqda;
+			x->profundidad = x->padre->profundidad + 1;
+		}
+
+		while ( true ) {
+			x->tam = 1;
+			x->hojas = x->izqda == 0 ? 1 : 0;
+			for ( N *h = x->izqda ; h != 0 ; h = h->drcha ) {
+				x->tam += h->tam;
+				x->hojas += h->hojas;
+			}
+
+			if ( x == r )
+				return;
+
+			if ( x->drcha != 0 ) {
+				x = x->drcha;
+				x->profundidad = x->padre->profundidad + 1;
+				break;
+			}
+			x = x->padre;
+		}
+	}
+}
+
+
+
+template <class N>
+void ConAnotaciones<N> :: Enlazado ( N* r ) {
+
+	N *p = r->padre;
+	bool eraHoja = p->izqda == r && r->drcha == 0; // r es su único hijo
+
+	Recalcular(r);
+	Ajustar(p, r->tam, r->hojas - (eraHoja ? 1 : 0));
+}
+
+
+
+template <class N>
+void ConAnotaciones<N> :: Desenlazado ( N* p, N* r ) {
+
+	bool esHoja = p->izqda == 0; // r era su único hijo
+
+	Ajustar(p, -r->tam, -r->hojas + (esHoja ? 1 : 0));
+	Recalcular(r);
+}
+
+
+
+template <class N>
+void ConAnotaciones<N> :: Ajustar ( N* n, int dnodos, int dhojas ) {
+
+	for ( ; n != 0 ; n = n->padre ) {
+		n->tam += dnodos;
+		n->hojas += dhojas;
+	}
+}
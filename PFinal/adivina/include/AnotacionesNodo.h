@@ -0,0 +1,84 @@
+#ifndef __AnotacionesNodo_h__
+#define __AnotacionesNodo_h__
+
+using namespace std;
+
+
+ /**
+  * @file AnotacionesNodo.h
+  * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+  * @date 14 de Diciembre de 2016, 14:30
+  * @brief Fichero cabecera de las politicas de anotacion de nodos del
+  *        TDA ArbolGeneral
+  *
+  * Una politica de anotacion es una plantilla \e M tal que el nodo \e N del
+  * árbol hereda de \e M<N>, de forma que sus campos forman parte de cada
+  * nodo, y que ofrece:
+  *
+  * - <tt>static void Recalcular(N* r)</tt> : recalcula las anotaciones del
+  * subárbol de \e r (no de sus hermanos) a partir de \e r->padre.
+  * - <tt>static void Enlazado(N* r)</tt> : \e r y sus descendientes acaban
+  * de colgarse de \e r->padre.
+  * - <tt>static void Desenlazado(N* p, N* r)</tt> : el subárbol de \e r,
+  * que colgaba de \e p, acaba de separarse de él y \e r es ya una raíz.
+  *
+  * El árbol llama a estas funciones tras cada operación que cambia la forma
+  * del árbol, y no lee nunca los campos de la anotación.
+  */
+
+
+ /**
+  * @brief Politica de anotacion por defecto
+  *
+  * No añade nada a los nodos y todas sus operaciones son vacías, por lo que
+  * no tiene coste ni en memoria ni en tiempo.
+  */
+template <class N>
+class SinAnotaciones {
+public:
+	static void Recalcular ( N* ) {}
+
+	static void Enlazado ( N* ) {}
+
+	static void Desenlazado ( N*, N* ) {}
+};
+
+
+
+ /**
+  * @brief Politica que anota en cada nodo su profundidad y el tamaño de su
+  * subárbol
+  *
+  * Con ella la profundidad de un nodo se consulta en O(1), y el k-ésimo
+  * nodo hoja se alcanza bajando desde la raíz por el hijo cuyo subárbol lo
+  * contiene (ver ArbolGeneral::HojaK).
+  *
+  * Mantenerla cuesta, en cada inserción o poda de una rama, O(h) para
+  * corregir los antecesores más O(m) para la propia rama, donde \e h es la
+  * altura del árbol y \e m el número de nodos de la rama.
+  */
+template <class N>
+class ConAnotaciones {
+public:
+	int profundidad;   /**< Distancia a la raíz, 0 en la raíz */
+	int tam;           /**< Nodos del subárbol, incluido el propio nodo */
+	int hojas;         /**< Hojas del subárbol */
+
+	ConAnotaciones () : profundidad(0), tam(1), hojas(1) {}
+
+	static void Recalcular ( N* r );
+
+	static void Enlazado ( N* r );
+
+	static void Desenlazado ( N* p, N* r );
+
+private:
+
+   /**
+  	* @brief Suma \e dnodos y \e dhojas al nodo \e n y a todos sus antecesores
+  	*/
+	static void Ajustar ( N* n, int dnodos, int dhojas );
+};
+
+#include "AnotacionesNodo.cpp"
+#endif
@@ -9,105 +9,249 @@
 
 #include <cassert>
 #include <iostream>
+#include <vector>
+#include <utility>
+#include <thread>
+#include <atomic>
 using namespace std;
 
 
 
 /**************************** METODOS PRIVADOS ******************************/
 
-template <class T>
-void ArbolGeneral<T> :: Destruir ( nodo* n ) {
-	
-  	if ( n != 0 ) {
-    	Destruir (n->izqda);
-		Destruir (n->drcha);
-		delete n;
-    	n = 0;
+template <class T, template <class> class A, template <class> class M>
+typename ArbolGeneral<T,A,M> :: nodo* ArbolGeneral<T,A,M> :: NuevoNodo ( const T& e ) {
+
+	nodo *n = A<nodo> :: Reservar();
+	n->etiqueta = e;
+	n->izqda = 0;
+	n->drcha = 0;
+	n->padre = 0;
+	return n;
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+void ArbolGeneral<T,A,M> :: BorrarNodo ( nodo* n ) {
+	A<nodo> :: Liberar(n);
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+void ArbolGeneral<T,A,M> :: Destruir ( nodo* n ) {
+
+	// Cada vez que n tiene hijo izquierda lo rotamos hacia arriba, de forma
+	// que el subárbol acaba siendo una lista por drcha que se libera en orden
+	while ( n != 0 ) {
+		if ( n->izqda != 0 ) {
+			nodo *hijo = n->izqda;
+			n->izqda = hijo->drcha;
+			hijo->drcha = n;
+			n = hijo;
+		}
+		else {
+			nodo *sig = n->drcha;
+			BorrarNodo (n);
+			n = sig;
+		}
 	}
 }
 
 
 
-template <class T>
-void ArbolGeneral<T> :: Copiar ( nodo*& dest, nodo* orig ) {
-	
+template <class T, template <class> class A, template <class> class M>
+int ArbolGeneral<T,A,M> :: Copiar ( nodo*& dest, const nodo* orig ) {
+
+	dest = 0;
 	if ( orig == 0 )
-		dest = 0;
+		return 0;
 
-	else {
-    	if ( laraiz == 0 ) {
-	      AsignaRaiz( orig->etiqueta ); 
-	      Copiar(dest->izqda,orig->izqda); // Copiamos hijo izquierda
-	      Copiar(dest->drcha,orig->drcha); // Copiamos hermano derecha
-    	}
-    	else {
-			dest = new nodo;
-		  	dest->etiqueta = orig->etiqueta;
-	      	dest->padre = 0;
-	      	dest->izqda = 0;
-	      	dest->drcha = 0;
-		  	Copiar( dest->izqda, orig->izqda );
-		  	Copiar ( dest->drcha, orig->drcha );
-    	}
-		if ( dest->izqda != 0 ) {
-			dest->izqda->padre = dest;
-      		nodo *aux = dest->izqda;
-			
-			while ( aux->drcha != 0 ) {
-				aux->drcha->padre = dest;
-        		aux = aux->drcha;
-      		}
+	dest = NuevoNodo ( orig->etiqueta );
+	int copiados = 1;
+
+	// Pila de nodos pendientes: hueco donde colgar la copia, nodo original y
+	// padre de la copia
+	struct Pendiente {
+		nodo **hueco;
+		const nodo *orig;
+		nodo *padre;
+	};
+	vector<Pendiente> pila;
+
+	if ( orig->izqda != 0 ) {
+		Pendiente p = { &dest->izqda, orig->izqda, dest };
+		pila.push_back(p);
+	}
+
+	while ( !pila.empty() ) {
+		Pendiente p = pila.back();
+		pila.pop_back();
+
+		nodo *copia = NuevoNodo ( p.orig->etiqueta );
+		copia->padre = p.padre;
+		*p.hueco = copia;
+		copiados++;
+
+		if ( p.orig->drcha != 0 ) { // Copiamos hermano derecha
+			Pendiente h = { &copia->drcha, p.orig->drcha, p.padre };
+			pila.push_back(h);
+		}
+		if ( p.orig->izqda != 0 ) { // Copiamos hijo izquierda
+			Pendiente h = { &copia->izqda, p.orig->izqda, copia };
+			pila.push_back(h);
 		}
 	}
+
+	return copiados;
 }
 
 
 
-template <class T>
-int ArbolGeneral<T> :: Contar ( const nodo* n ) const {
-	
-	if ( n == 0 )
-		return 0;
-	else
-		// Contamos el nodo padre + sus hijos de ambas ramas recursivamente
-		return ( 1 + Contar( n->izqda ) + Contar( n->drcha ) );
+template <class T, template <class> class A, template <class> class M>
+atomic<int>& ArbolGeneral<T,A,M> :: NumHilos () {
+
+	static atomic<int> hilos(thread :: hardware_concurrency() > 0 ? thread :: hardware_concurrency() : 1);
+	return hilos;
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+template <class F>
+void ArbolGeneral<T,A,M> :: Repartir ( int tareas, F tarea ) {
+
+	atomic<int> siguiente(0);
+	auto trabajador = [&] () {
+		for ( int i = siguiente++ ; i < tareas ; i = siguiente++ )
+			tarea(i);
+	};
+
+	// El hilo que llama también trabaja
+	vector<thread> hilos;
+	int total = NumHilos();
+	for ( int h = 1 ; h < total && h < tareas ; h++ )
+		hilos.push_back( thread(trabajador) );
+	trabajador();
+
+	for ( size_t h = 0 ; h < hilos.size() ; h++ )
+		hilos[h].join();
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+void ArbolGeneral<T,A,M> :: Destruir ( nodo* n, int tam ) {
+
+	if ( n == 0 || n->izqda == 0 || tam < UMBRAL_HILOS || NumHilos() <= 1 || !A<nodo> :: seguro_hilos ) {
+		Destruir(n);
+		return;
+	}
+
+	// Separamos los hijos para que cada uno se destruya sin sus hermanos
+	vector<nodo*> hijos;
+	for ( nodo *h = n->izqda ; h != 0 ; h = h->drcha )
+		hijos.push_back(h);
+	for ( size_t i = 0 ; i < hijos.size() ; i++ )
+		hijos[i]->drcha = 0;
+
+	Repartir(hijos.size(), [&] ( int i ) { Destruir(hijos[i]); });
+	BorrarNodo(n);
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+int ArbolGeneral<T,A,M> :: Copiar ( nodo*& dest, const nodo* orig, int tam ) {
+
+	if ( orig == 0 || orig->izqda == 0 || tam < UMBRAL_HILOS || NumHilos() <= 1 || !A<nodo> :: seguro_hilos )
+		return Copiar(dest, orig);
+
+	vector<const nodo*> hijos;
+	for ( const nodo *h = orig->izqda ; h != 0 ; h = h->drcha )
+		hijos.push_back(h);
+
+	// Cada hijo se copia por separado y después se enlazan en orden
+	vector<nodo*> copias(hijos.size());
+	vector<int> copiados(hijos.size());
+	Repartir(hijos.size(), [&] ( int i ) { copiados[i] = Copiar(copias[i], hijos[i]); });
+
+	dest = NuevoNodo ( orig->etiqueta );
+	int total = 1;
+	nodo **hueco = &dest->izqda;
+	for ( size_t i = 0 ; i < copias.size() ; i++ ) {
+		copias[i]->padre = dest;
+		*hueco = copias[i];
+		hueco = &copias[i]->drcha;
+		total += copiados[i];
+	}
+
+	return total;
 }
 
 
 
-template <class T>
-bool ArbolGeneral<T> :: SonIguales ( const nodo* n1, const nodo* n2 ) const {
+template <class T, template <class> class A, template <class> class M>
+int ArbolGeneral<T,A,M> :: Contar ( const nodo* n ) const {
+
+	int total = 0;
+	vector<const nodo*> pila;
+
+	if ( n != 0 )
+		pila.push_back(n);
+
+	// Contamos cada nodo y apilamos sus hijos de ambas ramas
+	while ( !pila.empty() ) {
+		const nodo *actual = pila.back();
+		pila.pop_back();
+		total++;
+
+		if ( actual->drcha != 0 )
+			pila.push_back(actual->drcha);
+		if ( actual->izqda != 0 )
+			pila.push_back(actual->izqda);
+	}
+
+	return total;
+}
+
+
 
-	if (n1 == 0 && n2 == 0)                      
-		return true;                             
+template <class T, template <class> class A, template <class> class M>
+bool ArbolGeneral<T,A,M> :: SonIguales ( const nodo* n1, const nodo* n2 ) const {
 
-	else if (n1 == 0 || n2 == 0)                  
-		return false;                            
+	vector< pair<const nodo*, const nodo*> > pila;
+	pila.push_back( make_pair(n1, n2) );
 
-	else if (n1->etiqueta != n2->etiqueta)      
-		return false;                           
+	while ( !pila.empty() ) {
+		const nodo *a = pila.back().first;
+		const nodo *b = pila.back().second;
+		pila.pop_back();
 
-	else if (!SonIguales(n1->izqda, n2->izqda)) 
-		return false;                            
+		if ( a == 0 && b == 0 )
+			continue;
 
-	else if (!SonIguales(n1->drcha, n2->drcha)) 
-		return false;                            
+		if ( a == 0 || b == 0 || a->etiqueta != b->etiqueta )
+			return false;
 
-	else                                       
-		return true;                             
+		pila.push_back( make_pair(a->drcha, b->drcha) );
+		pila.push_back( make_pair(a->izqda, b->izqda) );
+	}
 
+	return true;
 }
 
 
 
-template <class T>
-void ArbolGeneral<T> :: Escribe_arbol ( std::ostream& out, nodo* nod ) const {
+template <class T, template <class> class A, template <class> class M>
+void ArbolGeneral<T,A,M> :: Escribe_arbol ( std::ostream& out, nodo* nod ) const {
 
 	if (nod == 0)                                //Si el nodo es nulo
 		out << "x ";                           //escribimos 'x'
 
 	else {                                       //Si el nodo no es nulo
-		out << "n " << nod->etiqueta;   //escribimos su etiqueta
+		out << "n " << nod->etiqueta << " ";   //escribimos su etiqueta
     
     	nodo *aux = nod->izqda;
     	while (aux != 0) {
@@ -120,88 +264,201 @@ void ArbolGeneral<T> :: Escribe_arbol ( std::ostream& out, nodo* nod ) const {
 
 
 
-template <class T>
-void ArbolGeneral<T> :: Lee_arbol ( std::istream& in, nodo*& nod ) {
+template <class T, template <class> class A, template <class> class M>
+void ArbolGeneral<T,A,M> :: Lee_arbol ( std::istream& in, nodo*& nod ) {
 	
 	char c;
-	                     	   
-	//Lectura de un carácter
-	if (in.get(c))
-		switch (c) {
-			case 'x':
-				nod = 0;
-				break;
-
-			case 'n':
-				T et;
-				in >> et;
-				nod = new nodo;
-				nod->etiqueta = et;
-				nod->izqda = 0;
-				nod->drcha = 0;
-				nod->padre = 0;
-		
-				Lee_arbol(in, nod->izqda);
-				Lee_arbol(in, nod->drcha);
-
-				if ( nod->izqda != 0 ) {
-					nod->izqda->padre = nod;
-					nodo* aux = nod->izqda;
-
-					while ( aux->drcha != 0 ) {
-						aux->drcha->padre = nod;
-						aux = aux->drcha;
-					}
-				}
+	vector<nodo*> abiertos; // Nodos cuyos hijos se están leyendo
+	vector<nodo*> ultimos;  // Último hijo leído de cada nodo abierto
+
+	nod = 0;
+
+	//Lectura de un carácter, saltando separadores
+	while ( in >> c ) {
+		if ( c == 'n' ) {
+			T et;
+			in >> et;
+			nodo *nuevo = NuevoNodo(et);
+			nnodos++;
+
+			if ( abiertos.empty() )
+				nod = nuevo;
+			else {
+				nuevo->padre = abiertos.back();
+				if ( ultimos.back() == 0 )
+					abiertos.back()->izqda = nuevo;
+				else
+					ultimos.back()->drcha = nuevo;
+				ultimos.back() = nuevo;
+			}
+			abiertos.push_back(nuevo);
+			ultimos.push_back(0);
+		}
+		else if ( c == 'x' ) {
+			if ( abiertos.empty() ) // árbol vacío
 				break;
+			abiertos.pop_back();
+			ultimos.pop_back();
 		}
+		else {
+			in.setstate(std::ios::failbit);
+			break;
+		}
+
+		if ( abiertos.empty() ) // se ha cerrado la raíz
+			break;
+	}
 }			
 
 
 
 
+template <class T, template <class> class A, template <class> class M>
+typename ArbolGeneral<T,A,M> :: nodo* ArbolGeneral<T,A,M> :: PrimeroPostorden ( nodo* n, int &level ) {
+
+	while ( n->izqda != 0 ) {
+		n = n->izqda;
+		level++;
+	}
+	return n;
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+typename ArbolGeneral<T,A,M> :: nodo* ArbolGeneral<T,A,M> :: SiguientePostorden ( nodo* n, int &level ) {
+
+	if ( n->drcha != 0 ) // El hermano y todo su subárbol van antes que el padre
+		return PrimeroPostorden(n->drcha, level);
+
+	level--;
+	if ( n->padre == 0 ) // La raíz es el último nodo
+		level = -1;
+	return n->padre;
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+typename ArbolGeneral<T,A,M> :: nodo* ArbolGeneral<T,A,M> :: PrimeroEnNivel ( nodo* x, int d ) {
+
+	while ( x != 0 ) {
+		// Bajamos por los hijos más a la izquierda hasta el nivel buscado
+		while ( d > 0 && x->izqda != 0 ) {
+			x = x->izqda;
+			d--;
+		}
+		if ( d == 0 )
+			return x;
+
+		// Rama demasiado corta: seguimos por el primer hermano derecha 
+		// que encontremos subiendo
+		while ( x != 0 && x->drcha == 0 ) {
+			x = x->padre;
+			d++;
+		}
+		if ( x != 0 )
+			x = x->drcha;
+	}
+	return 0;
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+typename ArbolGeneral<T,A,M> :: nodo* ArbolGeneral<T,A,M> :: SiguienteNivel ( nodo* raiz, nodo* n, int &level ) {
+
+	// Siguiente nodo del mismo nivel
+	int d = 0;
+	while ( n != 0 && n->drcha == 0 ) {
+		n = n->padre;
+		d++;
+	}
+	nodo *sig = n != 0 ? PrimeroEnNivel(n->drcha, d) : 0;
+
+	// Si no lo hay, primer nodo del nivel siguiente (la raíz está en el -1)
+	if ( sig == 0 ) {
+		level++;
+		sig = PrimeroEnNivel(raiz, level + 1);
+	}
+	if ( sig == 0 )
+		level = -1;
+
+	return sig;
+}
+
+
+
+
 /**************************** METODOS PUBLICOS ******************************/
 
 
 
-template <class T>
-ArbolGeneral<T> :: ArbolGeneral() {
+template <class T, template <class> class A, template <class> class M>
+ArbolGeneral<T,A,M> :: ArbolGeneral() {
 	laraiz = 0; // se crea un arbol vacio
+	nnodos = 0;
+	reciclados = 0;
+	nreciclados = 0;
 }
 
 
 
-template <class T>
-ArbolGeneral<T> :: ArbolGeneral ( const T& e ) {
+template <class T, template <class> class A, template <class> class M>
+ArbolGeneral<T,A,M> :: ArbolGeneral ( const T& e ) {
 
 	laraiz = 0;
+	nnodos = 0;
+	reciclados = 0;
+	nreciclados = 0;
   	AsignaRaiz(e);	
 }
 
 
 
-template <class T>
-ArbolGeneral<T> :: ArbolGeneral ( const ArbolGeneral<T> &v ) {
+template <class T, template <class> class A, template <class> class M>
+ArbolGeneral<T,A,M> :: ArbolGeneral ( const ArbolGeneral<T,A,M> &v ) {
+
+	nnodos = Copiar (laraiz, v.laraiz, v.nnodos);
+	if ( laraiz != 0 )
+		M<nodo> :: Recalcular(laraiz);
+	reciclados = 0; // los reciclados no se copian
+	nreciclados = 0;
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+ArbolGeneral<T,A,M> :: ArbolGeneral ( ArbolGeneral<T,A,M> &&v ) {
 
-  	laraiz = 0;
-	Copiar (laraiz, v.laraiz);
+	laraiz = v.laraiz;
+	nnodos = v.nnodos;
+	reciclados = v.reciclados;
+	nreciclados = v.nreciclados;
+	v.laraiz = 0;
+	v.nnodos = 0;
+	v.reciclados = 0;
+	v.nreciclados = 0;
 }
 
 
 
-template <class T>
-ArbolGeneral<T> :: ~ArbolGeneral() {
-	Destruir (laraiz);
+template <class T, template <class> class A, template <class> class M>
+ArbolGeneral<T,A,M> :: ~ArbolGeneral() {
+	Destruir (laraiz, nnodos);
+	Destruir (reciclados);
 }
 
 
 
-template <class T>
-ArbolGeneral<T>& ArbolGeneral<T> :: operator = ( const ArbolGeneral<T> &v ) {
+template <class T, template <class> class A, template <class> class M>
+ArbolGeneral<T,A,M>& ArbolGeneral<T,A,M> :: operator = ( const ArbolGeneral<T,A,M> &v ) {
 
 	if ( this != &v ) {
-		Destruir (laraiz);
-		Copiar (laraiz, v.laraiz);
+		Destruir (laraiz, nnodos);
+		nnodos = Copiar (laraiz, v.laraiz, v.nnodos);
+		if ( laraiz != 0 )
+			M<nodo> :: Recalcular(laraiz);
 	}		
 	
 	return *this;
@@ -209,182 +466,395 @@ ArbolGeneral<T>& ArbolGeneral<T> :: operator = ( const ArbolGeneral<T> &v ) {
 
 
 
-template <class T>
-void ArbolGeneral<T> :: AsignaRaiz ( const T& e ) {
+template <class T, template <class> class A, template <class> class M>
+ArbolGeneral<T,A,M>& ArbolGeneral<T,A,M> :: operator = ( ArbolGeneral<T,A,M> &&v ) {
+
+	if ( this != &v ) {
+		Destruir (laraiz, nnodos);
+		Destruir (reciclados);
+		laraiz = v.laraiz;
+		nnodos = v.nnodos;
+		reciclados = v.reciclados;
+		nreciclados = v.nreciclados;
+		v.laraiz = 0;
+		v.nnodos = 0;
+		v.reciclados = 0;
+		v.nreciclados = 0;
+	}
+
+	return *this;
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+void ArbolGeneral<T,A,M> :: AsignaRaiz ( const T& e ) {
 
-	Destruir(laraiz);        //Destruye el árbol actual
-	laraiz = new nodo;    	 //Reservamos el nodo raíz
-	laraiz->padre = 0;       //No tiene padre,
-	laraiz->izqda = 0;       //ni hijo izquierda,
-	laraiz->drcha = 0;       //ni hijo derecha.
-	laraiz->etiqueta = e;    //Damos valor a la etiqueta de la raíz	
+	Destruir(laraiz, nnodos); //Destruye el árbol actual
+	laraiz = NuevoNodo(e);   //Reservamos el nodo raíz, sin padre ni hijos
+	nnodos = 1;
 }
 
 
 
-template <class T>
-typename ArbolGeneral<T> :: Nodo ArbolGeneral<T> :: Raiz() const {
+template <class T, template <class> class A, template <class> class M>
+typename ArbolGeneral<T,A,M> :: Nodo ArbolGeneral<T,A,M> :: Raiz() const {
 	return laraiz;
 }
 
 
 
-template <class T>
-typename ArbolGeneral<T> :: Nodo ArbolGeneral<T> :: HijoMasIzquierda ( const Nodo n ) const {
+template <class T, template <class> class A, template <class> class M>
+typename ArbolGeneral<T,A,M> :: Nodo ArbolGeneral<T,A,M> :: HijoMasIzquierda ( const Nodo n ) const {
 	return n->izqda;
 }
 
 
 
-template <class T>
-typename ArbolGeneral<T> :: Nodo ArbolGeneral<T> :: HermanoDerecha ( const Nodo n ) const {
+template <class T, template <class> class A, template <class> class M>
+typename ArbolGeneral<T,A,M> :: Nodo ArbolGeneral<T,A,M> :: HermanoDerecha ( const Nodo n ) const {
 	return n->drcha;
 }
 
 
 
-template <class T>
-typename ArbolGeneral<T> :: Nodo ArbolGeneral<T> :: Padre ( const Nodo n ) const {
+template <class T, template <class> class A, template <class> class M>
+typename ArbolGeneral<T,A,M> :: Nodo ArbolGeneral<T,A,M> :: Padre ( const Nodo n ) const {
 	return n->padre;
 }
  
    
 
-template <class T>
-T& ArbolGeneral<T> :: Etiqueta ( const Nodo n ) {
+template <class T, template <class> class A, template <class> class M>
+int ArbolGeneral<T,A,M> :: Profundidad ( const Nodo n ) const {
+	return n->profundidad;
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+int ArbolGeneral<T,A,M> :: NumHojas ( const Nodo n ) const {
+	return n->hojas;
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+typename ArbolGeneral<T,A,M> :: Nodo ArbolGeneral<T,A,M> :: HojaK ( int k ) const {
+
+	assert ( laraiz != 0 && 0 <= k && k < laraiz->hojas );
+	nodo *x = laraiz;
+
+	// En cada nivel saltamos los hijos cuyas hojas quedan antes de la k-ésima
+	while ( x->izqda != 0 ) {
+		nodo *h = x->izqda;
+		while ( k >= h->hojas ) {
+			k -= h->hojas;
+			h = h->drcha;
+		}
+		x = h;
+	}
+	return x;
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+void ArbolGeneral<T,A,M> :: Hilos ( int n ) {
+	NumHilos() = n > 1 ? n : 1;
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+int ArbolGeneral<T,A,M> :: Hilos () {
+	return NumHilos();
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+T& ArbolGeneral<T,A,M> :: Etiqueta ( const Nodo n ) {
 	return n->etiqueta;
 }
 
 
 
-template <class T>
-const T& ArbolGeneral<T> :: Etiqueta ( const Nodo n ) const {
+template <class T, template <class> class A, template <class> class M>
+const T& ArbolGeneral<T,A,M> :: Etiqueta ( const Nodo n ) const {
 	return n->etiqueta;
 }
 
 
 
-template <class T>
-void ArbolGeneral<T> :: Asignar_subarbol ( const ArbolGeneral<T> &orig, const Nodo nod ) {
+template <class T, template <class> class A, template <class> class M>
+void ArbolGeneral<T,A,M> :: Asignar_subarbol ( const ArbolGeneral<T,A,M> &orig, const Nodo nod ) {
 
-	Destruir (laraiz);         
-  	Copiar (laraiz,nod);       
-	if (laraiz != 0) {       	   
-		laraiz->padre = 0;
-    	Destruir(laraiz->drcha);
-  	}
+	Destruir (laraiz, nnodos);         
+  	nnodos = Copiar (laraiz,nod); // Copia nod y sus descendientes, no sus hermanos
+	if ( laraiz != 0 )
+		M<nodo> :: Recalcular(laraiz);
 }
 
 
 
-template <class T>
-void ArbolGeneral<T> :: Podar_hijoMasIzquierda ( Nodo n, ArbolGeneral<T> &dest ) {
+template <class T, template <class> class A, template <class> class M>
+void ArbolGeneral<T,A,M> :: Podar_hijoMasIzquierda ( Nodo n, ArbolGeneral<T,A,M> &dest ) {
 
 	if ( n->izqda != 0 ) {
+		dest.Clear();
 		dest.laraiz = n->izqda;
     	n->izqda = n->izqda->drcha;
     	dest.laraiz->drcha = 0;
     	dest.laraiz->padre = 0;
+		dest.nnodos = Contar(dest.laraiz);
+		nnodos -= dest.nnodos;
+		M<nodo> :: Desenlazado(n, dest.laraiz);
 	}
 }
 
 
 
-template <class T>
-void ArbolGeneral<T> :: Podar_hermanoDerecha ( Nodo n, ArbolGeneral<T> &dest ) {
+template <class T, template <class> class A, template <class> class M>
+void ArbolGeneral<T,A,M> :: Podar_hermanoDerecha ( Nodo n, ArbolGeneral<T,A,M> &dest ) {
 
 	if ( n->drcha != 0 ) {
+		dest.Clear();
 	    dest.laraiz = n->drcha;
 	    n->drcha = n->drcha->drcha;
 	    dest.laraiz->drcha = 0;
 	    dest.laraiz->padre = 0;
+		dest.nnodos = Contar(dest.laraiz);
+		nnodos -= dest.nnodos;
+		M<nodo> :: Desenlazado(n->padre, dest.laraiz);
   	}
 }
 
 
 
-template <class T>
-void ArbolGeneral<T> :: Insertar_hijoMasIzquierda ( Nodo n, ArbolGeneral<T> &rama ) {
+template <class T, template <class> class A, template <class> class M>
+void ArbolGeneral<T,A,M> :: Insertar_hijoMasIzquierda ( Nodo n, ArbolGeneral<T,A,M> &rama ) {
 
 	if ( !rama.Empty() ) { // Comprobamos que la rama tiene nodos
 	    Nodo aux; // Nodo auxiliar
 	    aux = n->izqda; // Guardamos el nodo hijo actual
-	    Copiar(n->izqda,rama.Raiz()); // Copiamos el contenido y creamos un nuevo hijo más izquierda
+	    Copiar(n->izqda,rama.Raiz(),rama.nnodos); // Copiamos el contenido y creamos un nuevo hijo más izquierda
 	    n->izqda->drcha = aux; // El hermano derecho del hijo izquierda actual es el hijo izquierdo anterior
 	    n->izqda->padre = n; // Le asignamos su padre
+	    M<nodo> :: Enlazado(n->izqda);
+	    nnodos += rama.nnodos;
 	    rama.Clear(); // Borramos los nodos de la rama.
   	}
 }
 
 
 
-template <class T>
-void ArbolGeneral<T> :: Insertar_hermanoDerecha ( Nodo n, ArbolGeneral<T> &rama ) {
+template <class T, template <class> class A, template <class> class M>
+void ArbolGeneral<T,A,M> :: Insertar_hijoMasIzquierda ( Nodo n, ArbolGeneral<T,A,M> &&rama ) {
+
+	if ( !rama.Empty() ) {
+		nodo *r = rama.laraiz;   // Enlazamos la raiz de la rama sin copiarla
+		r->drcha = n->izqda;     // El anterior hijo izquierda pasa a ser su hermano
+		r->padre = n;
+		n->izqda = r;
+		M<nodo> :: Enlazado(r);
+		nnodos += rama.nnodos;
+		rama.laraiz = 0;         // La rama ya no es dueña de sus nodos
+		rama.nnodos = 0;
+	}
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+void ArbolGeneral<T,A,M> :: Insertar_hermanoDerecha ( Nodo n, ArbolGeneral<T,A,M> &rama ) {
 
 	assert ( n->padre != 0 ); // Para que la raiz no tenga hermano a la derecha
   	if ( !rama.Empty() ){ // Comprobamos que la rama no esté vacia
 	    Nodo aux; // Nodo auxiliar
 	    aux = n->drcha; // aux contiene el hermano a la derecha actual
-	    Copiar ( n->drcha ,rama.Raiz() ); // Copiamos la rama en el hermano a la derecha de n
+	    Copiar ( n->drcha ,rama.Raiz(), rama.nnodos ); // Copiamos la rama en el hermano a la derecha de n
 	    n->drcha->drcha = aux; // Su hermano a la derecha de nodo apunta al hermano a la derecha anterior
 	    n->drcha->padre = n->padre; // Su padre es el mismo que el de sus hermanos
+	    M<nodo> :: Enlazado(n->drcha);
+	    nnodos += rama.nnodos;
 	    rama.Clear();
   	}
 }
 
 
 
-template <class T>
-void ArbolGeneral<T> :: Clear () {
+template <class T, template <class> class A, template <class> class M>
+void ArbolGeneral<T,A,M> :: Insertar_hermanoDerecha ( Nodo n, ArbolGeneral<T,A,M> &&rama ) {
+
+	assert ( n->padre != 0 ); // Para que la raiz no tenga hermano a la derecha
+	if ( !rama.Empty() ) {
+		nodo *r = rama.laraiz;   // Enlazamos la raiz de la rama sin copiarla
+		r->drcha = n->drcha;     // El anterior hermano derecho pasa a la derecha de r
+		r->padre = n->padre;
+		n->drcha = r;
+		M<nodo> :: Enlazado(r);
+		nnodos += rama.nnodos;
+		rama.laraiz = 0;         // La rama ya no es dueña de sus nodos
+		rama.nnodos = 0;
+	}
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+ArbolGeneral<T,A,M> ArbolGeneral<T,A,M> :: Rama ( const T& e ) {
+
+	ArbolGeneral<T,A,M> rama;
+
+	if ( reciclados == 0 )
+		rama.laraiz = NuevoNodo(e);
+	else {
+		nodo *n = reciclados;
+		reciclados = n->drcha;
+		nreciclados--;
+		static_cast< M<nodo>& >(*n) = M<nodo>(); // anotaciones de un nodo suelto
+		n->etiqueta = e;
+		n->drcha = 0;
+		rama.laraiz = n;
+	}
+	rama.nnodos = 1;
+
+	return rama;
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+void ArbolGeneral<T,A,M> :: Reciclar ( ArbolGeneral<T,A,M> &rama ) {
+
+	// Como en Destruir, pero cada nodo sin hijos pasa a la lista de reciclados
+	nodo *n = rama.laraiz;
+	while ( n != 0 ) {
+		if ( n->izqda != 0 ) {
+			nodo *hijo = n->izqda;
+			n->izqda = hijo->drcha;
+			hijo->drcha = n;
+			n = hijo;
+		}
+		else {
+			nodo *sig = n->drcha;
+			n->drcha = reciclados;
+			n->padre = 0;
+			reciclados = n;
+			nreciclados++;
+			n = sig;
+		}
+	}
+
+	rama.laraiz = 0;
+	rama.nnodos = 0;
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+int ArbolGeneral<T,A,M> :: Reciclados () const {
+	return nreciclados;
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+void ArbolGeneral<T,A,M> :: Clear () {
 
-	Destruir ( laraiz );
+	Destruir ( laraiz, nnodos );
+	Destruir ( reciclados );
 	laraiz = 0;
+	nnodos = 0;
+	reciclados = 0;
+	nreciclados = 0;
 } 
   
   
 
-template <class T>
-int ArbolGeneral<T> :: Size () const {
-	return Contar ( laraiz );
+template <class T, template <class> class A, template <class> class M>
+int ArbolGeneral<T,A,M> :: Size () const {
+	return nnodos;
 }
 
 
 
-template <class T>
-bool ArbolGeneral<T> :: Empty () const {
+template <class T, template <class> class A, template <class> class M>
+bool ArbolGeneral<T,A,M> :: Empty () const {
 	return laraiz == 0;
 }
 
 
 
-template <class T>
-bool ArbolGeneral<T> :: operator == ( const ArbolGeneral<T> &v ) const {
+template <class T, template <class> class A, template <class> class M>
+UsoMemoria ArbolGeneral<T,A,M> :: MemoryUsage () const {
+
+	UsoMemoria u;
+	u.nodos = nnodos * ( sizeof(nodo) - sizeof(T) );
+	u.en_linea = nnodos * sizeof(T);
+
+	for ( const_iter_preorden it = cbegin() ; it != cend() ; ++it ) {
+		size_t fuera = MemoriaExterna(*it);
+		u.heap += fuera;
+		if ( fuera > 0 )
+			u.cadenas_heap++;
+	}
+
+	// Los reciclados, con lo que sus etiquetas conservan fuera del nodo
+	for ( const nodo *n = reciclados ; n != 0 ; n = n->drcha )
+		u.holgura += sizeof(nodo) + MemoriaExterna(n->etiqueta);
+
+	return u;
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+size_t ArbolGeneral<T,A,M> :: HolguraAsignador () {
+	return A<nodo> :: Holgura();
+}
+
+
+
+template <class T, template <class> class A, template <class> class M>
+bool ArbolGeneral<T,A,M> :: operator == ( const ArbolGeneral<T,A,M> &v ) const {
 	return SonIguales ( laraiz, v.laraiz );
 }
     
 
 
-template <class T>
-bool ArbolGeneral<T> :: operator != ( const ArbolGeneral<T> &v ) const {
+template <class T, template <class> class A, template <class> class M>
+bool ArbolGeneral<T,A,M> :: operator != ( const ArbolGeneral<T,A,M> &v ) const {
 	return !(SonIguales(laraiz, v.laraiz));
 }
 
 
 
-template <class T> 
-std :: istream& operator>> ( std :: istream &in, ArbolGeneral<T> &v ) {
+template <class T, template <class> class A, template <class> class M>
+ArbolPlano<T> ArbolGeneral<T,A,M> :: freeze () const {
+	return ArbolPlano<T>(*this);
+}
+
+
+
+template <class T, template <class> class A, template <class> class M> 
+std :: istream& operator>> ( std :: istream &in, ArbolGeneral<T,A,M> &v ) {
 	
 	if ( !v.Empty() ) 
 		v.Clear();
 
+	v.nnodos = 0;
 	v.Lee_arbol ( in, v.laraiz );
+	if ( v.laraiz != 0 )
+		M<typename ArbolGeneral<T,A,M> :: nodo> :: Recalcular(v.laraiz);
 	return in;
 }
 
 
 
-template <class T>
-std :: ostream& operator<< ( std :: ostream &out, const ArbolGeneral<T> &v ) {
+template <class T, template <class> class A, template <class> class M>
+std :: ostream& operator<< ( std :: ostream &out, const ArbolGeneral<T,A,M> &v ) {
 
 	if ( v.laraiz != 0 )
 		v.Escribe_arbol ( out, v.laraiz );
@@ -398,8 +868,8 @@ std :: ostream& operator<< ( std :: ostream &out, const ArbolGeneral<T> &v ) {
 
 
 
-template <class T>
-ArbolGeneral<T> :: iter_preorden :: iter_preorden () {
+template <class T, template <class> class A, template <class> class M>
+ArbolGeneral<T,A,M> :: iter_preorden :: iter_preorden () {
 
 	it = 0;
 	raiz = 0;
@@ -408,15 +878,15 @@ ArbolGeneral<T> :: iter_preorden :: iter_preorden () {
 
 
 
-template <class T>
-T& ArbolGeneral<T> :: iter_preorden :: operator* () {
+template <class T, template <class> class A, template <class> class M>
+T& ArbolGeneral<T,A,M> :: iter_preorden :: operator* () {
 	return (*it).etiqueta;
 }
 
 
 
-template <class T>
-int ArbolGeneral<T> :: iter_preorden :: getLevel () const {
+template <class T, template <class> class A, template <class> class M>
+int ArbolGeneral<T,A,M> :: iter_preorden :: getLevel () const {
 	return level;
 }
 
@@ -426,8 +896,8 @@ int ArbolGeneral<T> :: iter_preorden :: getLevel () const {
   * @brief Compara si es un nodo hoja
   * @return true si no tiene hijo a la izquierda. False en caso contrario
   */
-template <class T>
-bool ArbolGeneral<T> :: iter_preorden :: Hoja () const {
+template <class T, template <class> class A, template <class> class M>
+bool ArbolGeneral<T,A,M> :: iter_preorden :: Hoja () const {
 	return it->izqda == 0;
 }
 
@@ -437,8 +907,8 @@ bool ArbolGeneral<T> :: iter_preorden :: Hoja () const {
   * @param i: iterador con el  que se compara
   * @return true si los dos iteradores son iguales (la raiz y el nodo son iguales). False en caso contrario
   */
-template <class T>
-bool ArbolGeneral<T> :: iter_preorden :: operator == (const iter_preorden &i) const {
+template <class T, template <class> class A, template <class> class M>
+bool ArbolGeneral<T,A,M> :: iter_preorden :: operator == (const iter_preorden &i) const {
 	return i.raiz == raiz && i.it == it && i.level == level;
 }
 
@@ -448,8 +918,8 @@ bool ArbolGeneral<T> :: iter_preorden :: operator == (const iter_preorden &i) co
   * @param i: iterador con el  que se compara
   * @return true si los dos iteradores son diferentes (la raiz o  el nodo son diferentes). False en caso contrario
   */
-template <class T>
-bool ArbolGeneral<T> :: iter_preorden :: operator != (const iter_preorden &i) const {
+template <class T, template <class> class A, template <class> class M>
+bool ArbolGeneral<T,A,M> :: iter_preorden :: operator != (const iter_preorden &i) const {
   	return i.raiz != raiz || i.it != it || i.level != level;
 }
 
@@ -459,8 +929,8 @@ bool ArbolGeneral<T> :: iter_preorden :: operator != (const iter_preorden &i) co
 
 
 
-template <class T>
-ArbolGeneral<T> :: const_iter_preorden :: const_iter_preorden () {
+template <class T, template <class> class A, template <class> class M>
+ArbolGeneral<T,A,M> :: const_iter_preorden :: const_iter_preorden () {
 
 	it = 0;
 	raiz = 0;
@@ -469,29 +939,29 @@ ArbolGeneral<T> :: const_iter_preorden :: const_iter_preorden () {
 
 
 
-template <class T>
-const T& ArbolGeneral<T> :: const_iter_preorden :: operator* () {
+template <class T, template <class> class A, template <class> class M>
+const T& ArbolGeneral<T,A,M> :: const_iter_preorden :: operator* () {
 	return (*it).etiqueta;
 }
 
 
 
-template <class T>
-int ArbolGeneral<T> :: const_iter_preorden :: getLevel () const {
+template <class T, template <class> class A, template <class> class M>
+int ArbolGeneral<T,A,M> :: const_iter_preorden :: getLevel () const {
 	return level;
 }
 
 
 
-template <class T>
-bool ArbolGeneral<T> :: const_iter_preorden :: Hoja () const {
+template <class T, template <class> class A, template <class> class M>
+bool ArbolGeneral<T,A,M> :: const_iter_preorden :: Hoja () const {
   	return it->izqda == 0;
 }
 
 
 
-template <class T>
-bool ArbolGeneral<T> :: const_iter_preorden :: operator == (const const_iter_preorden &i) const {
+template <class T, template <class> class A, template <class> class M>
+bool ArbolGeneral<T,A,M> :: const_iter_preorden :: operator == (const const_iter_preorden &i) const {
 	return i.raiz == raiz && i.it == it && i.level == level;
 }
 	 	    
@@ -500,8 +970,8 @@ bool ArbolGeneral<T> :: const_iter_preorden :: operator == (const const_iter_pre
   * @param i: iterador con el con que se comparación
   * @return true si los dos iteradores son diferentes (la raiz o  el nodo son diferentes). False en caso contrario
   */
-template <class T>
-bool ArbolGeneral<T> :: const_iter_preorden :: operator != (const const_iter_preorden &i) const {
+template <class T, template <class> class A, template <class> class M>
+bool ArbolGeneral<T,A,M> :: const_iter_preorden :: operator != (const const_iter_preorden &i) const {
 	return i.raiz != raiz || i.it != it || i.level != level;
 }
 
@@ -4,10 +4,15 @@
 #include <cassert>
 #include <iostream>
 #include <queue>
+#include <atomic>
+#include "AsignadorNodos.h"
+#include "AnotacionesNodo.h"
+#include "UsoMemoria.h"
 
 
 using namespace std;
 
+template <class T> class ArbolPlano; // declaracion adelantada, ver ArbolPlano.h
 
  /**
   * @brief T.D.A. ArbolGeneral
@@ -32,6 +37,16 @@ using namespace std;
   * 
   * El espacio requerido para el almacenamiento es O(n), donde n es el número de
   * nodos del árbol.
+  *
+  * El segundo parámetro \e A es la política de reserva de los nodos (ver
+  * AsignadorNodos.h). Por defecto cada nodo se reserva con \e new
+  * (AsignadorHeap); con AsignadorPool los nodos se toman de bloques
+  * contiguos, lo que abarata construir y destruir árboles grandes.
+  *
+  * El tercer parámetro \e M es la política de anotación de los nodos (ver
+  * AnotacionesNodo.h). Por defecto (SinAnotaciones) los nodos no guardan
+  * nada más; con ConAnotaciones cada nodo guarda su profundidad y el tamaño
+  * de su subárbol, y se pueden usar Profundidad, NumHojas y HojaK.
   * 
   * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
   * @date 14/12/2016
@@ -46,7 +61,7 @@ using namespace std;
   *  
   */
 
-template <class T>
+template <class T, template <class> class A = AsignadorHeap, template <class> class M = SinAnotaciones>
 class ArbolGeneral {
 
  /**
@@ -61,7 +76,7 @@ private:
    * implementa como un conjunto de nodos enlazados según la relación 
    * padre-hijo más a la izquierda-hermano derecha.
    */
-  struct nodo {
+  struct nodo : public M<nodo> {
    /**
   	* @brief Elemento almacenado
   	*
@@ -101,12 +116,51 @@ private:
   * del árbol. Vale 0 si el árbol es vacío.
   */
 	struct nodo *laraiz;
+
+ /**
+  * @brief Número de nodos
+  *
+  * Número de nodos del árbol. Se actualiza en cada operación que añade o 
+  * quita nodos, de forma que Size() no tenga que recorrer el árbol.
+  */
+	int nnodos;
+
+ /**
+  * @brief Nodos reciclados
+  *
+  * Lista, enlazada por \e drcha, de los nodos que se han quitado del árbol
+  * con Reciclar y que Rama vuelve a usar. Pertenecen a este árbol, no a la
+  * política \e A: no hay estado común entre árboles ni entre hilos.
+  */
+	struct nodo *reciclados;
+
+ /**
+  * @brief Número de nodos reciclados
+  */
+	int nreciclados;
+
+ /**
+  * @brief Reserva un nodo
+  * @param e Etiqueta del nuevo nodo
+  * @return Nodo reservado con la política \e A, con etiqueta \e e y todos
+  * sus punteros a 0.
+  */
+	nodo* NuevoNodo (const T& e);
+
+ /**
+  * @brief Libera un nodo
+  * @param n Nodo a liberar. No se liberan sus descendientes.
+  */
+	void BorrarNodo (nodo* n);
     
  /**
   * @brief Destruye el subárbol
-  * @param n Nodo a destruir, junto con sus descendientes
+  * @param n Nodo a destruir, junto con sus descendientes y sus hermanos a 
+  * la derecha
   *
-  * Libera los recursos que ocupan \e n y sus descendientes.
+  * Libera los recursos que ocupan \e n y sus descendientes. No es 
+  * recursivo: usa memoria adicional O(1), por lo que admite árboles de 
+  * cualquier profundidad o número de hermanos.
   */
 	void Destruir(nodo * n);
     
@@ -114,18 +168,67 @@ private:
   * @brief Copia un subárbol
   * @param dest Referencia al puntero del que cuelga la copia
   * @param orig Puntero a la raíz del subárbol a copiar
+  * @return Número de nodos copiados
+  *
+  * Hace una copia del subárbol que cuelga de \e orig (\e orig y sus 
+  * descendientes, pero no sus hermanos) en el puntero \e dest. Es 
+  * importante ver que en \e dest->padre no se asigna ningún valor, pues no
+  * se conoce. No es recursivo: usa una pila explícita.
+  */
+	int Copiar(nodo* &dest, const nodo* orig);
+
+ /**
+  * @brief Número mínimo de nodos para repartir una copia o una destrucción
+  * entre varios hilos. Por debajo, crear los hilos cuesta más que el 
+  * trabajo que ahorran.
+  */
+	static const int UMBRAL_HILOS = 50000;
+
+ /**
+  * @brief Destruye un árbol completo, repartiendo el trabajo entre hilos
+  * @param n Raíz del árbol (sin hermanos)
+  * @param tam Número de nodos de \e n
   *
-  * Hace una copia de todo el subárbol que cuelga de \e orig en el puntero
-  * \e dest. Es importante ver que en \e dest->padre (si existe) no se 
-  * asigna ningún valor, pues no se conoce.
+  * Si \e tam llega a UMBRAL_HILOS, se pueden usar varios hilos (ver Hilos)
+  * y la política \e A es segura entre hilos, cada hijo de \e n se destruye
+  * con Destruir en alguno de los hilos. En otro caso equivale a 
+  * Destruir(n).
   */
-	void Copiar(nodo* &dest, nodo* orig);
+	void Destruir(nodo * n, int tam);
+
+ /**
+  * @brief Copia un subárbol, repartiendo el trabajo entre hilos
+  * @param dest Referencia al puntero del que cuelga la copia
+  * @param orig Puntero a la raíz del subárbol a copiar
+  * @param tam Número de nodos del subárbol de \e orig
+  * @return Número de nodos copiados
+  *
+  * Con las mismas condiciones que Destruir(n, tam), copia cada hijo de 
+  * \e orig con Copiar en alguno de los hilos y después los enlaza bajo la
+  * copia de \e orig. En otro caso equivale a Copiar(dest, orig).
+  */
+	int Copiar(nodo* &dest, const nodo* orig, int tam);
+
+ /**
+  * @brief Ejecuta tarea(i) para cada i en [0, tareas) usando hasta Hilos()
+  * hilos, que van tomando la siguiente tarea pendiente hasta acabarlas
+  */
+	template <class F>
+	static void Repartir (int tareas, F tarea);
+
+ /**
+  * @brief Número de hilos configurado, común a todos los árboles del tipo
+  * @note Es atómico porque Hilos(n) puede llamarse mientras otro hilo
+  * copia o destruye un árbol del mismo tipo
+  */
+	static std::atomic<int>& NumHilos ();
       
  /**
   * @brief Cuenta el número de nodos
   * @param n Nodo del que cuelga el subárbol de nodos a contabilizar.
   *
-  * Cuenta cuántos nodos cuelgan de \e n, incluido éste.
+  * Cuenta cuántos nodos cuelgan de \e n, incluido éste y sus hermanos a la
+  * derecha. No es recursivo: usa una pila explícita.
   */
 	int Contar(const nodo* n) const;
     
@@ -136,7 +239,7 @@ private:
   *
   * Comprueba si son iguales los subárboles que cuelgan de \e n1 y \e n2. 
   * Para ello deberán tener los mismos nodos en las mismas posiciones y 
-  * con las mismas etiquetas.
+  * con las mismas etiquetas. No es recursivo: usa una pila explícita.
   */
 	bool SonIguales(const nodo* n1, const nodo* n2) const;
 
@@ -151,7 +254,11 @@ private:
   *
   * - Si el nodo es nulo, imprime el carácter 'x'.
   * - Si el nodo no es nulo, imprime el carácter 'n' seguido de un 
-  * espacio, al que sigue la impresión de la etiqueta
+  * espacio, al que sigue la impresión de la etiqueta y otro espacio, sus
+  * hijos y por último el carácter 'x'.
+  *
+  * Las etiquetas no pueden ser vacías ni contener separadores; para esos 
+  * casos está el formato binario (ver ArbolMapeado).
   */
   void Escribe_arbol (std::ostream& out, nodo* nod) const;
     
@@ -161,11 +268,57 @@ private:
   * @param nod Referencia al nodo que contendrá el subárbol leído
   *
   * Lee del flujo de entrada \e in los elementos de un árbol según el 
-  * formato que se presenta en la función de escritura.
+  * formato que se presenta en la función de escritura. No es recursivo, 
+  * por lo que admite cualquier número de hermanos. Si encuentra un 
+  * carácter que no es 'n' ni 'x' activa el failbit de \e in.
   *
   * @see escribe_arbol
   */
   void Lee_arbol (std::istream& in, nodo* &nod);
+
+ /**
+  * @brief Primer nodo en postorden del subárbol de un nodo
+  * @param n Nodo raíz del subárbol, no nulo
+  * @param level Nivel de \e n; al terminar, nivel del nodo devuelto
+  * @return El descendiente de \e n que se alcanza bajando siempre por el 
+  * hijo más a la izquierda
+  */
+  static nodo* PrimeroPostorden (nodo* n, int &level);
+
+ /**
+  * @brief Siguiente nodo en postorden
+  * @param n Nodo actual, no nulo
+  * @param level Nivel de \e n; al terminar, nivel del nodo devuelto
+  * @return El siguiente nodo en postorden, o 0 si \e n es la raíz
+  *
+  * Usa sólo los enlaces del árbol, sin memoria adicional. Un recorrido 
+  * completo se realiza en tiempo O(n).
+  */
+  static nodo* SiguientePostorden (nodo* n, int &level);
+
+ /**
+  * @brief Primer nodo de un nivel a partir de un nodo
+  * @param x Nodo desde el que se busca, hacia abajo y hacia la derecha
+  * @param d Número de niveles que hay entre \e x y el nivel buscado
+  * @return El primer nodo del nivel buscado que aparece, de izquierda a 
+  * derecha, en el subárbol de \e x o a su derecha. 0 si no hay ninguno.
+  */
+  static nodo* PrimeroEnNivel (nodo* x, int d);
+
+ /**
+  * @brief Siguiente nodo en el recorrido por niveles
+  * @param raiz Raíz del árbol recorrido
+  * @param n Nodo actual, no nulo
+  * @param level Nivel de \e n; al terminar, nivel del nodo devuelto
+  * @return El nodo a la derecha de \e n en su nivel o, si no lo hay, el 
+  * primero del nivel siguiente. 0 si \e n es el último nodo.
+  *
+  * Usa sólo los enlaces del árbol (incluido \e padre), sin cola auxiliar.
+  * Cada paso recorre el camino entre dos nodos consecutivos del nivel, y 
+  * los subárboles que no llegan a ese nivel; en árboles de altura uniforme 
+  * (como el de Refranes) el recorrido completo es prácticamente lineal.
+  */
+  static nodo* SiguienteNivel (nodo* raiz, nodo* n, int &level);
       
 
 public:
@@ -218,7 +371,16 @@ public:
   * La operación se realiza en tiempo O(n), donde \e n es el número
   * de elementos de \e v.
   */
-	ArbolGeneral (const ArbolGeneral<T>& v);
+	ArbolGeneral (const ArbolGeneral<T,A,M>& v);
+
+ /**
+  * @brief Constructor de movimiento
+  * @param v ArbolGeneral cuyos nodos pasan al árbol receptor
+  *
+  * Construye el árbol tomando los nodos de \e v sin copiarlos. \e v queda
+  * vacío. La operación se realiza en tiempo O(1).
+  */
+	ArbolGeneral (ArbolGeneral<T,A,M>&& v);
 
  /**
   * @brief Destructor
@@ -239,7 +401,18 @@ public:
   * La operación se realiza en tiempo O(n), donde \e n es el número de 
   * elementos de \e v.
   */
-	ArbolGeneral<T>& operator= (const ArbolGeneral<T> &v);
+	ArbolGeneral<T,A,M>& operator= (const ArbolGeneral<T,A,M> &v);
+
+ /**
+  * @brief Operador de asignación por movimiento
+  * @param v ArbolGeneral cuyos nodos pasan al árbol receptor
+  * @return Referencia al árbol receptor.
+  *
+  * Libera los nodos del árbol receptor y toma los de \e v sin copiarlos. 
+  * \e v queda vacío. La operación se realiza en tiempo O(n), donde \e n es
+  * el número de elementos del árbol receptor.
+  */
+	ArbolGeneral<T,A,M>& operator= (ArbolGeneral<T,A,M> &&v);
 
  /**
   * @brief Asignar nodo raíz
@@ -294,6 +467,55 @@ public:
   */
 	Nodo Padre (const Nodo n) const;
 
+ /**
+  * @brief Profundidad de un nodo
+  * @param n Nodo del que se quiere la profundidad
+  * @pre \e n no es nulo y el árbol usa la política ConAnotaciones
+  * @return Número de antecesores de \e n: 0 para la raíz. Coincide con el
+  * nivel de iter_preorden más uno.
+  *
+  * La operación se realiza en tiempo O(1).
+  */
+	int Profundidad (const Nodo n) const;
+
+ /**
+  * @brief Número de hojas de un subárbol
+  * @param n Nodo raíz del subárbol
+  * @pre \e n no es nulo y el árbol usa la política ConAnotaciones
+  *
+  * La operación se realiza en tiempo O(1).
+  */
+	int NumHojas (const Nodo n) const;
+
+ /**
+  * @brief Hoja k-ésima
+  * @param k Posición de la hoja, empezando en 0, según el recorrido en 
+  * preorden
+  * @pre El árbol no es vacío, usa la política ConAnotaciones y 
+  * 0 <= k < NumHojas(Raiz())
+  * @return La hoja que ocupa la posición \e k
+  *
+  * Baja desde la raíz eligiendo en cada nivel el hijo cuyo subárbol 
+  * contiene la hoja buscada. La operación se realiza en tiempo O(h·g), 
+  * donde \e h es la altura del árbol y \e g el máximo número de hijos.
+  */
+	Nodo HojaK (int k) const;
+
+ /**
+  * @brief Fija el número de hilos para copiar y destruir árboles grandes
+  * @param n Número de hilos; con 1 todas las operaciones son secuenciales
+  *
+  * El valor es común a todos los árboles con los mismos parámetros. Por 
+  * defecto es el número de núcleos de la máquina. Con una política de 
+  * reserva que no es segura entre hilos (AsignadorPool) no tiene efecto.
+  */
+	static void Hilos (int n);
+
+ /**
+  * @brief Número de hilos para copiar y destruir árboles grandes
+  */
+	static int Hilos ();
+
  /**
   * @brief Etiqueta de un nodo
   * @param n Nodo en el que se encuentra el elemento.
@@ -328,7 +550,7 @@ public:
   * nodo \e nod en el árbol \e orig. La operación se realiza en tiempo
   * O(n), donde \e n es el número de nodos del subárbol copiado.
   */
-	void Asignar_subarbol (const ArbolGeneral<T>& orig, const Nodo nod);
+	void Asignar_subarbol (const ArbolGeneral<T,A,M>& orig, const Nodo nod);
 
  /**
   * @brief Podar subárbol hijo más a la izquierda
@@ -339,9 +561,10 @@ public:
   * Asigna un nuevo valor al árbol \e dest, con todos los elementos del 
   * subárbol izquierdo del nodo \e n en el árbol receptor. Éste se queda 
   * sin dichos nodos.
-  *  La operación se realiza en tiempo O(1).
+  * La operación se realiza en tiempo O(k), donde \e k es el número de nodos
+  * podados, pues hay que descontarlos del tamaño del árbol receptor.
   */
-	void Podar_hijoMasIzquierda (Nodo n, ArbolGeneral<T>& dest);
+	void Podar_hijoMasIzquierda (Nodo n, ArbolGeneral<T,A,M>& dest);
 
  /**
   * @brief Podar subárbol hermano derecha
@@ -352,9 +575,10 @@ public:
   * Asigna un nuevo valor al árbol \e dest, con todos los elementos del 
   * subárbol hermano derecho del nodo \e n en el árbol receptor. Éste se 
   * queda sin dichos nodos.
-  * La operación se realiza en tiempo O(1).
+  * La operación se realiza en tiempo O(k), donde \e k es el número de nodos
+  * podados, pues hay que descontarlos del tamaño del árbol receptor.
   */
-	void Podar_hermanoDerecha (Nodo n, ArbolGeneral<T>& dest);
+	void Podar_hermanoDerecha (Nodo n, ArbolGeneral<T,A,M>& dest);
 
  /**
   * @brief Insertar subárbol hijo más a la izquierda
@@ -368,8 +592,23 @@ public:
   * estaban en el subárbol hijo más a la izquierda de \e n se desplazan a 
   * la derecha, de forma que el anterior hijo más a la izquierda pasa a ser
   * el hermano a la derecha del nuevo hijo más a la izquierda.
+  * Los nodos de \e rama se copian. La operación se realiza en tiempo O(k),
+  * donde \e k es el número de nodos de \e rama.
   */
-	void Insertar_hijoMasIzquierda (Nodo n, ArbolGeneral<T>& rama);
+	void Insertar_hijoMasIzquierda (Nodo n, ArbolGeneral<T,A,M>& rama);
+
+ /**
+  * @brief Insertar subárbol hijo más a la izquierda sin copia
+  * @param n: Nodo al que se insertará el árbol \e rama como hijo más a la 
+  * izquierda.
+  * @param rama Árbol temporal que se insertará como hijo más a la izquierda.
+  * @pre \e n no es nulo y es un nodo válido del árbol receptor
+  *
+  * Igual que la versión anterior, pero los nodos de \e rama se enlazan 
+  * directamente en el árbol receptor en lugar de copiarse. La operación se
+  * realiza en tiempo O(1).
+  */
+	void Insertar_hijoMasIzquierda (Nodo n, ArbolGeneral<T,A,M>&& rama);
 
  /**
   * @brief Insertar subárbol hermano derecha
@@ -381,15 +620,61 @@ public:
   * El árbol \e rama se inserta como hermano derecho del nodo \e n del 
   * árbol receptor. El árbol \e rama queda vacío y los nodos que estaban a 
   * la derecha del nodo \e n pasan a la derecha del nuevo nodo.
+  * Los nodos de \e rama se copian. La operación se realiza en tiempo O(k),
+  * donde \e k es el número de nodos de \e rama.
+  */
+	void Insertar_hermanoDerecha (Nodo n, ArbolGeneral<T,A,M>& rama);
+
+ /**
+  * @brief Insertar subárbol hermano derecha sin copia
+  * @param n Nodo al que se insertará el árbol \e rama como hermano a la 
+  * derecha. 
+  * @param rama Árbol temporal que se insertará como hermano derecho.
+  * @pre \e n no es nulo y es un nodo válido del árbol receptor
+  *
+  * Igual que la versión anterior, pero los nodos de \e rama se enlazan 
+  * directamente en el árbol receptor en lugar de copiarse. La operación se
+  * realiza en tiempo O(1).
   */
-	void Insertar_hermanoDerecha (Nodo n, ArbolGeneral<T>& rama);
+	void Insertar_hermanoDerecha (Nodo n, ArbolGeneral<T,A,M>&& rama);
+
+ /**
+  * @brief Árbol de un solo nodo, con un nodo reciclado
+  * @param e Etiqueta del nodo
+  * @return Un árbol con un solo nodo de etiqueta \e e, pensado para 
+  * insertarlo sin copia en el árbol receptor.
+  *
+  * Si el árbol receptor tiene nodos reciclados (ver Reciclar) usa uno de 
+  * ellos, y su etiqueta se asigna sobre la anterior (una cadena conserva su
+  * memoria); si no, reserva uno nuevo con la política \e A. La operación 
+  * se realiza en tiempo O(1).
+  */
+	ArbolGeneral<T,A,M> Rama (const T& e);
+
+ /**
+  * @brief Guarda los nodos de un árbol para volver a usarlos
+  * @param rama Árbol cuyos nodos se reciclan, normalmente una rama podada
+  * del árbol receptor. Queda vacío.
+  *
+  * Los nodos de \e rama no se liberan: pasan a la lista de reciclados del
+  * árbol receptor, de la que los toma Rama. Se liberan al destruir el árbol
+  * receptor o con Clear. La operación se realiza en tiempo O(k), donde \e k
+  * es el número de nodos de \e rama.
+  */
+	void Reciclar (ArbolGeneral<T,A,M>& rama);
+
+ /**
+  * @brief Número de nodos reciclados
+  * @return Los nodos guardados con Reciclar que Rama aún no ha usado.
+  */
+	int Reciclados () const;
 
  /**
   * @brief Borra todos los elementos
   *
-  * Borra todos los elementos del árbol receptor. Cuando termina, el árbol
-  * está vacía. La operación se realiza en tiempo O(n), donde \e n es el 
-  * número de elementos del árbol receptor.
+  * Borra todos los elementos del árbol receptor, y libera sus nodos 
+  * reciclados. Cuando termina, el árbol está vacía. La operación se realiza
+  * en tiempo O(n), donde \e n es el número de elementos del árbol receptor.
   */
 	void Clear();
 
@@ -397,8 +682,7 @@ public:
   * @brief Número de elementos
   * @return El número de elementos del árbol receptor.
   *
-  * La operación se realiza en tiempo O(n).
-  * @see contar
+  * La operación se realiza en tiempo O(1).
   */
 	int Size() const;
 
@@ -411,6 +695,26 @@ public:
   */
 	bool Empty() const;
 
+ /**
+  * @brief Memoria ocupada
+  * @return Los bytes de los nodos, de las etiquetas dentro de ellos y de lo
+  * que estas reservan fuera (ver UsoMemoria). Como holgura, los nodos 
+  * reciclados del árbol (ver Reciclar), que son solo suyos.
+  *
+  * No incluye la holgura de la política \e A, que es común a todos los
+  * árboles del tipo y se contaría una vez por árbol al sumar los desgloses
+  * (ver HolguraAsignador). La operación se realiza en tiempo O(n).
+  */
+	UsoMemoria MemoryUsage() const;
+
+ /**
+  * @brief Holgura de la política de reserva
+  * @return Los bytes que la política \e A tiene reservados al sistema sin 
+  * ningún nodo vivo, comunes a todos los árboles del tipo: 0 con 
+  * AsignadorHeap, los huecos libres de sus bloques con AsignadorPool.
+  */
+	static size_t HolguraAsignador();
+
  /**
   * @brief Operador de comparación (igualdad)
   * @param v ArbolGeneral con el que se desea comparar.
@@ -420,7 +724,7 @@ public:
   * La operación se realiza en tiempo O(n).
   * @see soniguales
   */
-	bool operator == (const ArbolGeneral<T>& v) const;
+	bool operator == (const ArbolGeneral<T,A,M>& v) const;
     
  /**
   * @brief Operador de comparación (diferencia)
@@ -430,7 +734,18 @@ public:
   *
   * La operación se realiza en tiempo O(n).
   */
-	bool operator != (const ArbolGeneral<T>& v) const;
+	bool operator != (const ArbolGeneral<T,A,M>& v) const;
+
+ /**
+  * @brief Copia inmutable y aplanada del árbol
+  * @return Un ArbolPlano con los nodos del árbol receptor en preorden
+  *
+  * Pensada para árboles que ya no se van a modificar: los recorridos sobre
+  * la copia son barridos lineales de memoria. La operación se realiza en 
+  * tiempo O(n).
+  * @see ArbolPlano
+  */
+	ArbolPlano<T> freeze () const;
 
 
  /**
@@ -457,8 +772,8 @@ public:
   * la lectura se puede consultar en la función de salida.
   * @see lee_arbol
   */
-	template <class U>
-	friend std::istream& operator>> (std::istream& in, ArbolGeneral<U> &v);
+	template <class U, template <class> class B, template <class> class C>
+	friend std::istream& operator>> (std::istream& in, ArbolGeneral<U,B,C> &v);
 
  /**
   * @brief Operador de inserción en flujo
@@ -477,8 +792,8 @@ public:
   *
   * @see escribe_arbol
   */
-	template <class U>
-	friend std::ostream& operator<< (std::ostream& out, const ArbolGeneral<U> &v);
+	template <class U, template <class> class B, template <class> class C>
+	friend std::ostream& operator<< (std::ostream& out, const ArbolGeneral<U,B,C> &v);
 
 
 	class const_iter_preorden;//declaracion adelantada
@@ -556,6 +871,40 @@ public:
   		}
   		return *this;
  	  } 
+
+   /**
+  	* @brief Avanza al siguiente nodo en preorden que no está en el subárbol 
+  	* del nodo actual, sin visitar ninguno de sus descendientes
+  	* @note Sube por \e padre hasta encontrar un hermano derecha. Recorrer 
+  	* un árbol saltando subárboles cuesta O(1) amortizado por salto.
+  	*/
+ 	  iter_preorden& SkipSubtree () {
+
+  		while ( it->padre != 0 && it->drcha == 0 ) {
+  			it = it->padre;
+  			level = level-1;
+  		}
+  		if ( it->drcha != 0 )
+  			it = it->drcha;
+  		else {
+  			it = 0;
+  			level = -1;
+  		}
+  		return *this;
+ 	  }
+
+   /**
+  	* @brief Avanza al hermano derecha del nodo actual, en O(1)
+  	* @note Si no tiene hermano derecha el iterador pasa a ser el final del 
+  	* recorrido
+  	*/
+ 	  iter_preorden& NextSibling () {
+
+  		it = it->drcha;
+  		if ( it == 0 )
+  			level = -1;
+  		return *this;
+ 	  }
 	 
    /**
   	* @brief Compara dos iteradores
@@ -654,6 +1003,40 @@ public:
   		}
   		return *this;
  		}
+
+   /**
+  	* @brief Avanza al siguiente nodo en preorden que no está en el subárbol 
+  	* del nodo actual, sin visitar ninguno de sus descendientes
+  	* @note Sube por \e padre hasta encontrar un hermano derecha. Recorrer 
+  	* un árbol saltando subárboles cuesta O(1) amortizado por salto.
+  	*/
+ 	  const_iter_preorden& SkipSubtree () {
+
+  		while ( it->padre != 0 && it->drcha == 0 ) {
+  			it = it->padre;
+  			level = level-1;
+  		}
+  		if ( it->drcha != 0 )
+  			it = it->drcha;
+  		else {
+  			it = 0;
+  			level = -1;
+  		}
+  		return *this;
+ 	  }
+
+   /**
+  	* @brief Avanza al hermano derecha del nodo actual, en O(1)
+  	* @note Si no tiene hermano derecha el iterador pasa a ser el final del 
+  	* recorrido
+  	*/
+ 	  const_iter_preorden& NextSibling () {
+
+  		it = it->drcha;
+  		if ( it == 0 )
+  			level = -1;
+  		return *this;
+ 	  }
 		    
    /**
   	* @brief Compara dos iteradores
@@ -724,6 +1107,251 @@ public:
    	return it;
  	}
 
+ /**
+  * @brief TDA. Iterador del ArbolGeneral en postorden
+  *
+  * Recorre primero los hijos de cada nodo, de izquierda a derecha, y luego
+  * el propio nodo; la raíz es el último. No reserva memoria: se mueve por 
+  * los enlaces \e drcha, \e izqda y \e padre.
+  */
+	class iter_postorden {
+	private:
+		Nodo it;    // Puntero al nodo
+		Nodo raiz;  // Puntero a la raiz del arbol donde esta it
+		int level;  // altura del nodo
+
+	public:
+		iter_postorden () : it(0), raiz(0), level(-1) {}
+
+		T& operator* () { return it->etiqueta; }
+		int getLevel () const { return level; }
+		Nodo GetNodo () const { return it; }
+		bool Hoja () const { return it->izqda == 0; }
+
+		iter_postorden& operator++ () {
+			it = SiguientePostorden(it, level);
+			return *this;
+		}
+
+		bool operator== (const iter_postorden &i) const {
+			return i.raiz == raiz && i.it == it;
+		}
+		bool operator!= (const iter_postorden &i) const {
+			return i.raiz != raiz || i.it != it;
+		}
+
+		friend class ArbolGeneral;
+	};
+
+ /**
+  * @brief TDA. Iterador constante del ArbolGeneral en postorden
+  */
+	class const_iter_postorden {
+	private:
+		Nodo it;    // Puntero al nodo
+		Nodo raiz;  // Puntero a la raiz del arbol donde esta it
+		int level;  // altura del nodo
+
+	public:
+		const_iter_postorden () : it(0), raiz(0), level(-1) {}
+		const_iter_postorden (const iter_postorden &i) : it(i.it), raiz(i.raiz), level(i.level) {}
+
+		const T& operator* () const { return it->etiqueta; }
+		int getLevel () const { return level; }
+		Nodo GetNodo () const { return it; }
+		bool Hoja () const { return it->izqda == 0; }
+
+		const_iter_postorden& operator++ () {
+			it = SiguientePostorden(it, level);
+			return *this;
+		}
+
+		bool operator== (const const_iter_postorden &i) const {
+			return i.raiz == raiz && i.it == it;
+		}
+		bool operator!= (const const_iter_postorden &i) const {
+			return i.raiz != raiz || i.it != it;
+		}
+
+		friend class ArbolGeneral;
+	};
+
+ /**
+  * @brief TDA. Iterador del ArbolGeneral por niveles (en anchura)
+  *
+  * Recorre la raíz, después todos los nodos del nivel 0 de izquierda a 
+  * derecha, después los del nivel 1, y así sucesivamente. No usa cola: 
+  * pasa de un nodo al siguiente de su nivel a través de \e padre.
+  */
+	class iter_nivel {
+	private:
+		Nodo it;    // Puntero al nodo
+		Nodo raiz;  // Puntero a la raiz del arbol donde esta it
+		int level;  // altura del nodo
+
+	public:
+		iter_nivel () : it(0), raiz(0), level(-1) {}
+
+		T& operator* () { return it->etiqueta; }
+		int getLevel () const { return level; }
+		Nodo GetNodo () const { return it; }
+		bool Hoja () const { return it->izqda == 0; }
+
+		iter_nivel& operator++ () {
+			it = SiguienteNivel(raiz, it, level);
+			return *this;
+		}
+
+		bool operator== (const iter_nivel &i) const {
+			return i.raiz == raiz && i.it == it;
+		}
+		bool operator!= (const iter_nivel &i) const {
+			return i.raiz != raiz || i.it != it;
+		}
+
+		friend class ArbolGeneral;
+	};
+
+ /**
+  * @brief TDA. Iterador constante del ArbolGeneral por niveles
+  */
+	class const_iter_nivel {
+	private:
+		Nodo it;    // Puntero al nodo
+		Nodo raiz;  // Puntero a la raiz del arbol donde esta it
+		int level;  // altura del nodo
+
+	public:
+		const_iter_nivel () : it(0), raiz(0), level(-1) {}
+		const_iter_nivel (const iter_nivel &i) : it(i.it), raiz(i.raiz), level(i.level) {}
+
+		const T& operator* () const { return it->etiqueta; }
+		int getLevel () const { return level; }
+		Nodo GetNodo () const { return it; }
+		bool Hoja () const { return it->izqda == 0; }
+
+		const_iter_nivel& operator++ () {
+			it = SiguienteNivel(raiz, it, level);
+			return *this;
+		}
+
+		bool operator== (const const_iter_nivel &i) const {
+			return i.raiz == raiz && i.it == it;
+		}
+		bool operator!= (const const_iter_nivel &i) const {
+			return i.raiz != raiz || i.it != it;
+		}
+
+		friend class ArbolGeneral;
+	};
+
+
+ /**
+	* @brief Iterador en preorden situado en un nodo
+	* @param n Nodo del árbol en el que se sitúa el iterador
+	* @pre \e n es un nodo de este árbol y el árbol usa ConAnotaciones, de
+	* donde se toma su nivel en O(1)
+	*/
+	iter_preorden Posicion ( const Nodo n ) {
+		iter_preorden it;
+		it.it = n;
+		it.raiz = laraiz;
+		it.level = Profundidad(n) - 1;
+		return it;
+	}
+
+ /**
+	* @brief Iterador constante en preorden situado en un nodo
+	* @param n Nodo del árbol en el que se sitúa el iterador
+	* @pre Las mismas que Posicion
+	*/
+	const_iter_preorden Posicion ( const Nodo n ) const {
+		const_iter_preorden it;
+		it.it = n;
+		it.raiz = laraiz;
+		it.level = Profundidad(n) - 1;
+		return it;
+	}
+
+ /**
+	* @brief Iterador al primer nodo en postorden (la hoja más a la izquierda)
+	*/
+	iter_postorden begin_postorden () {
+		iter_postorden it;
+		it.raiz = laraiz;
+		if ( laraiz != 0 )
+			it.it = PrimeroPostorden(laraiz, it.level);
+		return it;
+	}
+
+ /**
+	* @brief Iterador al nodo nulo, fin del recorrido en postorden
+	*/
+	iter_postorden end_postorden () {
+		iter_postorden it;
+		it.raiz = laraiz;
+		return it;
+	}
+
+ /**
+	* @brief Iterador constante al primer nodo en postorden
+	*/
+	const_iter_postorden cbegin_postorden () const {
+		const_iter_postorden it;
+		it.raiz = laraiz;
+		if ( laraiz != 0 )
+			it.it = PrimeroPostorden(laraiz, it.level);
+		return it;
+	}
+
+ /**
+	* @brief Iterador constante al nodo nulo, fin del recorrido en postorden
+	*/
+	const_iter_postorden cend_postorden () const {
+		const_iter_postorden it;
+		it.raiz = laraiz;
+		return it;
+	}
+
+ /**
+	* @brief Iterador por niveles a la raiz del arbol. Nivel -1
+	*/
+	iter_nivel begin_nivel () {
+		iter_nivel it;
+		it.raiz = laraiz;
+		it.it = laraiz;
+		return it;
+	}
+
+ /**
+	* @brief Iterador al nodo nulo, fin del recorrido por niveles
+	*/
+	iter_nivel end_nivel () {
+		iter_nivel it;
+		it.raiz = laraiz;
+		return it;
+	}
+
+ /**
+	* @brief Iterador constante por niveles a la raiz del arbol. Nivel -1
+	*/
+	const_iter_nivel cbegin_nivel () const {
+		const_iter_nivel it;
+		it.raiz = laraiz;
+		it.it = laraiz;
+		return it;
+	}
+
+ /**
+	* @brief Iterador constante al nodo nulo, fin del recorrido por niveles
+	*/
+	const_iter_nivel cend_nivel () const {
+		const_iter_nivel it;
+		it.raiz = laraiz;
+		return it;
+	}
+
 };
 #include "ArbolGeneral.cpp"
+#include "ArbolPlano.h"
 #endif
@@ -0,0 +1,223 @@
+#ifndef __ArbolMapeado_h__
+#define __ArbolMapeado_h__
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "ArbolGeneral.h"
+
+using namespace std;
+
+
+/**
+ * @file ArbolMapeado.h
+ * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+ * @date 24/01/2017
+ * @brief Fichero cabecera del TDA ArbolMapeado: formato binario de un
+ *        ArbolGeneral de cadenas, usado directamente desde el fichero
+ *        proyectado en memoria (mmap)
+ */
+
+
+class ArbolMapeado {
+
+/**
+ * @page T.D.A. ArbolMapeado
+ *
+ * @section esArbolMapeado Conjunto Especificacion
+ * Una instancia \e a del tipo de dato abstracto ArbolMapeado es un
+ * ArbolGeneral<string> de solo lectura cuyo contenido está en un fichero
+ * binario proyectado en memoria. Abrir el fichero no lee ni reserva nada
+ * por nodo: las páginas se cargan a medida que se consultan.
+ *
+ * @section formatoArbolMapeado Formato del fichero (version 1)
+ *
+ *  - Cabecera : CabeceraBinaria (magia "AGB1", version, numero de nodos y
+ *    tamaño de la zona de cadenas).
+ *  - Tabla de nodos : un NodoBinario por nodo, en preorden, con la misma
+ *    disposicion que ArbolPlano (fin de subarbol, padre y nivel).
+ *  - Zona de cadenas : las etiquetas seguidas, sin separadores, de forma
+ *    que pueden contener cualquier caracter. Si se escribe compartiendo
+ *    colas (ver AlmacenColas) una etiqueta que es el final de otra no ocupa
+ *    nada: su entrada apunta al final de la otra. Los lectores no notan la
+ *    diferencia, ya que cada nodo tiene su propia posicion y longitud.
+ *
+ * Los enteros se guardan en el orden de bytes de la maquina que escribe.
+ */
+
+public:
+
+  /**
+   * @brief Cabecera del fichero binario
+   */
+  struct CabeceraBinaria {
+    char magia[4];          /**< "AGB1" */
+    uint32_t version;       /**< Version del formato */
+    uint32_t nodos;         /**< Numero de nodos */
+    uint32_t tam_cadenas;   /**< Bytes de la zona de cadenas */
+  };
+
+  /**
+   * @brief Entrada de la tabla de nodos
+   */
+  struct NodoBinario {
+    uint32_t inicio;        /**< Posicion de la etiqueta en la zona de cadenas */
+    uint32_t longitud;      /**< Longitud de la etiqueta */
+    uint32_t fin;           /**< Posicion siguiente al ultimo nodo del subarbol */
+    int32_t padre;          /**< Posicion del padre, -1 para la raiz */
+    int32_t nivel;          /**< Nivel del nodo, -1 para la raiz */
+  };
+
+  static const uint32_t VERSION = 1; /**< Version que se escribe y se acepta */
+
+private:
+
+  void *datos;                    /**< Inicio de la proyeccion, 0 si no hay fichero */
+  size_t tam;                     /**< Bytes proyectados */
+  const NodoBinario *tabla;       /**< Tabla de nodos dentro de la proyeccion */
+  const char *cadenas;            /**< Zona de cadenas dentro de la proyeccion */
+  int n;                          /**< Numero de nodos */
+
+  /**
+   * @brief Comprueba que la tabla de nodos describe un arbol valido
+   * @param tabla : tabla de nodos del fichero
+   * @param n : numero de nodos
+   * @param tam_cadenas : bytes de la zona de cadenas
+   * @return true si cada etiqueta esta dentro de la zona de cadenas y fin,
+   *         padre y nivel son los de un recorrido en preorden: la raiz en 0,
+   *         cada padre antes que su hijo y cada subarbol dentro del de su padre
+   * @note El fichero puede venir de cualquier sitio: ninguna consulta ni
+   *       Volcar miran la tabla sin que Abrir la haya comprobado. O(n)
+   */
+  static bool Valida ( const NodoBinario *tabla, int n, uint32_t tam_cadenas );
+
+public:
+
+  /**
+   * @brief Constructor por defecto. No hay ningun fichero abierto
+   */
+  ArbolMapeado();
+
+  /**
+   * @brief Destructor. Deshace la proyeccion si la hay
+   */
+  ~ArbolMapeado();
+
+  ArbolMapeado ( const ArbolMapeado& ) = delete;
+  ArbolMapeado& operator= ( const ArbolMapeado& ) = delete;
+
+  /**
+   * @brief Proyecta en memoria un fichero binario
+   * @param fichero : ruta del fichero
+   * @return true si el fichero existe y tiene un formato valido, cabecera y
+   *         tabla de nodos incluidas (ver Valida). Si no, no queda abierto
+   */
+  bool Abrir ( const string &fichero );
+
+  /**
+   * @brief Deshace la proyeccion
+   */
+  void Cerrar ();
+
+  /**
+   * @brief Comprueba si un fichero empieza por la cabecera del formato binario
+   * @param fichero : ruta del fichero
+   */
+  static bool EsBinario ( const string &fichero );
+
+  /**
+   * @brief Escribe un arbol en formato binario
+   * @param os : flujo de salida, abierto en modo binario
+   * @param plano : arbol aplanado a escribir (ver ArbolGeneral::freeze)
+   * @param compartir_colas : si es true, la zona de cadenas es un AlmacenColas
+   *        de las etiquetas en lugar de las etiquetas seguidas
+   * @return true si se ha podido escribir
+   */
+  static bool Escribir ( ostream &os, const ArbolPlano<string> &plano, bool compartir_colas = false );
+
+  /**
+   * @brief Numero de nodos
+   */
+  int Size () const { return n; }
+
+  /**
+   * @brief Puntero a la etiqueta del nodo i, sin copiarla
+   * @pre 0 <= i < Size(). La etiqueta no acaba en '\0', ver Longitud
+   */
+  const char* Datos ( int i ) const { return cadenas + tabla[i].inicio; }
+
+  /**
+   * @brief Longitud de la etiqueta del nodo i
+   */
+  int Longitud ( int i ) const { return tabla[i].longitud; }
+
+  /**
+   * @brief Copia de la etiqueta del nodo i
+   */
+  string Etiqueta ( int i ) const { return string(Datos(i), Longitud(i)); }
+
+  /**
+   * @brief Posicion siguiente al ultimo nodo del subarbol de i
+   */
+  int FinSubarbol ( int i ) const { return tabla[i].fin; }
+
+  /**
+   * @brief Padre del nodo i, -1 si es la raiz
+   */
+  int Padre ( int i ) const { return tabla[i].padre; }
+
+  /**
+   * @brief Nivel del nodo i, con el mismo criterio que iter_preorden
+   */
+  int Nivel ( int i ) const { return tabla[i].nivel; }
+
+  /**
+   * @brief Hoja
+   * @return true si el nodo i no tiene hijos
+   */
+  bool Hoja ( int i ) const { return FinSubarbol(i) == i + 1; }
+
+  /**
+   * @brief Reconstruye en memoria el arbol proyectado
+   * @param ab : arbol que recibe los nodos, se vacia antes
+   * @note Recorre la tabla una sola vez y enlaza cada nodo en O(1), sin
+   *       analizar texto.
+   */
+  template <template <class> class A, template <class> class M>
+  void Volcar ( ArbolGeneral<string,A,M> &ab ) const;
+};
+
+
+
+template <template <class> class A, template <class> class M>
+void ArbolMapeado :: Volcar ( ArbolGeneral<string,A,M> &ab ) const {
+
+  typedef typename ArbolGeneral<string,A,M> :: Nodo Nodo;
+
+  ab.Clear();
+  if ( n == 0 )
+    return;
+
+  vector<Nodo> nodos(n);        // nodo de ab creado para cada posicion
+  vector<Nodo> ultimo(n, Nodo(0)); // ultimo hijo enlazado de cada posicion
+
+  ab.AsignaRaiz(Etiqueta(0));
+  nodos[0] = ab.Raiz();
+
+  for ( int i = 1 ; i < n ; i++ ) {
+    int p = Padre(i);
+
+    if ( ultimo[p] == 0 ) {
+      ab.Insertar_hijoMasIzquierda(nodos[p], ArbolGeneral<string,A,M>(Etiqueta(i)));
+      nodos[i] = ab.HijoMasIzquierda(nodos[p]);
+    }
+    else {
+      ab.Insertar_hermanoDerecha(ultimo[p], ArbolGeneral<string,A,M>(Etiqueta(i)));
+      nodos[i] = ab.HermanoDerecha(ultimo[p]);
+    }
+    ultimo[p] = nodos[i];
+  }
+}
+
+#endif
@@ -0,0 +1,46 @@
+ /**
+  * @file ArbolPlano.cpp
+  * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+  * @date 14 de Diciembre de 2016, 14:52
+  * @brief Fichero implementacion del TDA ArbolPlano
+  *
+  */
+
+
+
+template <class T>
+template <template <class> class A, template <class> class M>
+ArbolPlano<T> :: ArbolPlano ( const ArbolGeneral<T,A,M> &ab ) {
+
+	int n = ab.Size();
+	etiquetas.reserve(n);
+	fin.reserve(n);
+	padres.reserve(n);
+	niveles.reserve(n);
+
+	// Pila de nodos cuyo subárbol aún no se ha cerrado
+	vector<int> abiertos;
+
+	typename ArbolGeneral<T,A,M> :: const_iter_preorden it = ab.cbegin();
+	for ( ; it != ab.cend() ; ++it ) {
+		int i = etiquetas.size();
+		int nivel = it.getLevel();
+
+		// Se cierran los subárboles de los nodos de igual o mayor nivel
+		while ( !abiertos.empty() && niveles[abiertos.back()] >= nivel ) {
+			fin[abiertos.back()] = i;
+			abiertos.pop_back();
+		}
+
+		etiquetas.push_back(*it);
+		fin.push_back(i + 1);
+		padres.push_back( abiertos.empty() ? -1 : abiertos.back() );
+		niveles.push_back(nivel);
+		abiertos.push_back(i);
+	}
+
+	while ( !abiertos.empty() ) {
+		fin[abiertos.back()] = etiquetas.size();
+		abiertos.pop_back();
+	}
+}
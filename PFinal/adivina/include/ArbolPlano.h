@@ -0,0 +1,250 @@
+#ifndef __ArbolPlano_h__
+#define __ArbolPlano_h__
+
+#include <cassert>
+#include <vector>
+#include "ArbolGeneral.h"
+#include "UsoMemoria.h"
+
+using namespace std;
+
+
+ /**
+  * @brief T.D.A. ArbolPlano
+  *
+  * \b Definición:
+  * Una instancia \e a del tipo de dato abstracto ArbolPlano sobre un dominio
+  * \e T es una copia inmutable de un ArbolGeneral sobre \e T, almacenada en
+  * preorden en vectores contiguos.
+  *
+  * Se obtiene con ArbolGeneral::freeze() y está pensada para árboles que ya
+  * no se modifican: un recorrido en preorden pasa a ser un barrido lineal de
+  * memoria en lugar de seguir punteros dispersos por el heap, y saltarse un
+  * subárbol completo cuesta O(1).
+  *
+  * Para poder usar el tipo de dato ArbolPlano se debe incluir el fichero
+  *
+  * <tt>\#include ArbolPlano.h</tt>
+  *
+  * El espacio requerido para el almacenamiento es O(n), donde n es el número
+  * de nodos del árbol.
+  *
+  * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+  * @date 14/12/2016
+  */
+
+
+ /**
+  * @file ArbolPlano.cpp
+  * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+  * @date 14 de Diciembre de 2016, 14:30
+  * @brief Fichero implementacion del TDA ArbolPlano
+  *
+  */
+
+template <class T>
+class ArbolPlano {
+
+ /**
+  * @page repArbolPlano Rep del TDA Arbol Plano
+  *
+  * El nodo \e i es el i-ésimo nodo del árbol en preorden. Su subárbol
+  * ocupa las posiciones [i, fin[i]), de forma que \e i es hoja si
+  * fin[i] == i+1 y el siguiente nodo fuera de su subárbol es fin[i].
+  */
+private:
+
+	vector<T> etiquetas;   /**< Etiqueta de cada nodo, en preorden */
+	vector<int> fin;       /**< Posición siguiente al último nodo del subárbol */
+	vector<int> padres;    /**< Posición del padre, -1 para la raíz */
+	vector<int> niveles;   /**< Nivel del nodo, -1 para la raíz (como iter_preorden) */
+
+public:
+
+ /**
+  * @brief Constructor por defecto. Crea un árbol plano vacío
+  */
+	ArbolPlano () {}
+
+ /**
+  * @brief Construye el árbol plano a partir de un ArbolGeneral
+  * @param ab Árbol a aplanar
+  *
+  * La operación se realiza en tiempo O(n), donde \e n es el número de nodos
+  * de \e ab.
+  */
+	template <template <class> class A, template <class> class M>
+	explicit ArbolPlano ( const ArbolGeneral<T,A,M> &ab );
+
+ /**
+  * @brief Número de nodos
+  */
+	int Size () const {
+		return etiquetas.size();
+	}
+
+ /**
+  * @brief Vacío
+  */
+	bool Empty () const {
+		return etiquetas.empty();
+	}
+
+ /**
+  * @brief Etiqueta del nodo \e i
+  * @pre 0 <= i < Size()
+  */
+	const T& Etiqueta ( int i ) const {
+		return etiquetas[i];
+	}
+
+ /**
+  * @brief Padre del nodo \e i, -1 si es la raíz
+  * @pre 0 <= i < Size()
+  */
+	int Padre ( int i ) const {
+		return padres[i];
+	}
+
+ /**
+  * @brief Posición siguiente al último nodo del subárbol de \e i
+  * @pre 0 <= i < Size()
+  */
+	int FinSubarbol ( int i ) const {
+		return fin[i];
+	}
+
+ /**
+  * @brief Nivel del nodo \e i, con el mismo criterio que iter_preorden
+  * @pre 0 <= i < Size()
+  */
+	int Nivel ( int i ) const {
+		return niveles[i];
+	}
+
+ /**
+  * @brief Memoria ocupada
+  * @return Los vectores de posiciones como nodos, los de etiquetas como
+  * en_linea y lo que las etiquetas reservan fuera como heap (ver UsoMemoria)
+  */
+	UsoMemoria MemoryUsage () const {
+		UsoMemoria u;
+		u.nodos = ( fin.capacity() + padres.capacity() + niveles.capacity() ) * sizeof(int);
+		u.en_linea = etiquetas.capacity() * sizeof(T);
+		for ( size_t i = 0 ; i < etiquetas.size() ; i++ ) {
+			size_t fuera = MemoriaExterna(etiquetas[i]);
+			u.heap += fuera;
+			if ( fuera > 0 )
+				u.cadenas_heap++;
+		}
+		return u;
+	}
+
+
+ /**
+  * @brief TDA. Iterador constante del ArbolPlano en preorden
+  *
+  * Ofrece las mismas operaciones que ArbolGeneral::const_iter_preorden, y
+  * además saltar el subárbol del nodo actual en O(1).
+  */
+	class const_iter_preorden {
+	private:
+		const ArbolPlano<T> *arbol; // Árbol recorrido
+		int i;                      // Posición del nodo, Size() al final
+
+	public:
+   /**
+  	* @brief Constructor por defecto
+  	*/
+		const_iter_preorden () : arbol(0), i(0) {}
+
+   /**
+  	* @brief Obtiene la etiqueta del nodo
+  	*/
+		const T& operator* () const {
+			return arbol->etiquetas[i];
+		}
+
+   /**
+  	* @brief Obtiene el nivel del nodo
+  	*/
+		int getLevel () const {
+			return i < arbol->Size() ? arbol->niveles[i] : -1;
+		}
+
+   /**
+  	* @brief Obtiene la posición del nodo en el árbol plano
+  	*/
+		int GetNodo () const {
+			return i;
+		}
+
+   /**
+  	* @brief Compara si es un nodo hoja
+  	* @return true si no tiene hijos. False en caso contrario
+  	*/
+		bool Hoja () const {
+			return arbol->fin[i] == i + 1;
+		}
+
+   /**
+  	* @brief Avanza al siguiente nodo segun el recorrido en preorden
+  	*/
+		const_iter_preorden& operator++ () {
+			i++;
+			return *this;
+		}
+
+   /**
+  	* @brief Avanza al siguiente nodo en preorden que no está en el
+  	* subárbol del nodo actual. La operación se realiza en tiempo O(1).
+  	*/
+		const_iter_preorden& SkipSubtree () {
+			i = arbol->fin[i];
+			return *this;
+		}
+
+   /**
+  	* @brief Avanza al hermano derecha del nodo actual, en O(1). Si no lo
+  	* tiene, el iterador pasa a ser cend()
+  	*/
+		const_iter_preorden& NextSibling () {
+			int j = arbol->fin[i];
+			i = ( j < arbol->Size() && arbol->padres[j] == arbol->padres[i] ) ? j : arbol->Size();
+			return *this;
+		}
+
+		bool operator== ( const const_iter_preorden &it ) const {
+			return arbol == it.arbol && i == it.i;
+		}
+
+		bool operator!= ( const const_iter_preorden &it ) const {
+			return arbol != it.arbol || i != it.i;
+		}
+
+		friend class ArbolPlano;
+	};
+
+ /**
+  * @brief Iterador a la raíz del árbol
+  */
+	const_iter_preorden cbegin () const {
+		const_iter_preorden it;
+		it.arbol = this;
+		it.i = 0;
+		return it;
+	}
+
+ /**
+  * @brief Iterador a la posición siguiente al último nodo
+  */
+	const_iter_preorden cend () const {
+		const_iter_preorden it;
+		it.arbol = this;
+		it.i = Size();
+		return it;
+	}
+};
+
+#include "ArbolPlano.cpp"
+#endif
@@ -0,0 +1,77 @@
+ /**
+  * @file AsignadorNodos.cpp
+  * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+  * @date 14 de Diciembre de 2016, 14:52
+  * @brief Fichero implementacion de las politicas de reserva de nodos
+  *
+  */
+
+
+
+/***************************** ASIGNADOR POOL *******************************/
+
+
+
+template <class N>
+AsignadorPool<N> :: Reserva :: ~Reserva () {
+
+	for ( size_t i = 0 ; i < bloques.size() ; i++ )
+		::operator delete ( bloques[i] );
+}
+
+
+
+template <class N>
+typename AsignadorPool<N> :: Reserva& AsignadorPool<N> :: Estado () {
+
+	static Reserva r;
+	return r;
+}
+
+
+
+template <class N>
+void AsignadorPool<N> :: NuevoBloque ( Reserva& r ) {
+
+	Hueco *bloque = static_cast<Hueco*>( ::operator new ( NODOS_BLOQUE * sizeof(Hueco) ) );
+	r.bloques.push_back(bloque);
+
+	// Encadenamos los huecos del bloque delante de la lista de libres
+	for ( size_t i = 0 ; i + 1 < NODOS_BLOQUE ; i++ )
+		bloque[i].sig = &bloque[i+1];
+
+	bloque[NODOS_BLOQUE-1].sig = r.libres;
+	r.libres = bloque;
+}
+
+
+
+template <class N>
+N* AsignadorPool<N> :: Reservar () {
+
+	Reserva &r = Estado();
+
+	if ( r.libres == 0 )
+		NuevoBloque(r);
+
+	Hueco *h = r.libres;
+	r.libres = h->sig;
+	r.vivos++;
+
+	return new (h->dato) N;
+}
+
+
+
+template <class N>
+void AsignadorPool<N> :: Liberar ( N* n ) {
+
+	if ( n != 0 ) {
+		n->~N();
+		Hueco *h = reinterpret_cast<Hueco*>(n);
+		Reserva &r = Estado();
+		h->sig = r.libres;
+		r.libres = h;
+		r.vivos--;
+	}
+}
@@ -0,0 +1,128 @@
+#ifndef __AsignadorNodos_h__
+#define __AsignadorNodos_h__
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+using namespace std;
+
+
+ /**
+  * @file AsignadorNodos.h
+  * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+  * @date 14 de Diciembre de 2016, 14:30
+  * @brief Fichero cabecera de las politicas de reserva de nodos del
+  *        TDA ArbolGeneral
+  *
+  * Una politica de reserva es una plantilla \e A tal que \e A<N> ofrece:
+  *
+  * - <tt>static N* Reservar()</tt> : devuelve un \e N construido por defecto.
+  * - <tt>static void Liberar(N* n)</tt> : destruye y libera \e n.
+  * - <tt>static const bool seguro_hilos</tt> : \e true si Reservar y Liberar
+  * pueden llamarse desde varios hilos a la vez.
+  * - <tt>static size_t Holgura()</tt> : bytes reservados al sistema que no
+  * ocupa ningún nodo vivo (ver ArbolGeneral::HolguraAsignador).
+  *
+  * Como los nodos pasan de un árbol a otro (Podar_*, Insertar_*), la reserva
+  * no pertenece a ningún árbol concreto: es común a todos los árboles que
+  * usan el mismo tipo de nodo.
+  */
+
+
+ /**
+  * @brief Politica de reserva por defecto
+  *
+  * Cada nodo se reserva y libera por separado con \e new y \e delete.
+  */
+template <class N>
+class AsignadorHeap {
+public:
+	static const bool seguro_hilos = true;
+
+	static N* Reservar () {
+		return new N;
+	}
+
+	static void Liberar ( N* n ) {
+		delete n;
+	}
+
+	static size_t Holgura () {
+		return 0;
+	}
+};
+
+
+
+ /**
+  * @brief Politica de reserva por bloques (pool)
+  *
+  * Los nodos se toman de bloques contiguos de \e NODOS_BLOQUE nodos. Los nodos
+  * liberados pasan a una lista de libres y se reutilizan antes de pedir un
+  * bloque nuevo, de modo que construir y destruir un árbol de \e n nodos
+  * requiere unas n / NODOS_BLOQUE reservas de memoria.
+  *
+  * Los bloques no se devuelven al sistema hasta que termina el programa, por
+  * lo que ningún árbol que use esta política debe sobrevivir a \e main.
+  * La reserva es común a todo el programa y no es segura entre hilos.
+  */
+template <class N>
+class AsignadorPool {
+private:
+
+	static const size_t NODOS_BLOQUE = 4096;
+
+   /**
+  	* @brief Hueco de un bloque: o bien un nodo vivo o bien un enlace al
+  	* siguiente hueco libre.
+  	*/
+	union Hueco {
+		Hueco *sig;
+		alignas(N) unsigned char dato[sizeof(N)];
+	};
+
+   /**
+  	* @brief Estado común de la reserva: bloques pedidos y lista de libres.
+  	*/
+	struct Reserva {
+		vector<Hueco*> bloques;
+		Hueco *libres;
+		size_t vivos;   // nodos reservados y no liberados
+
+		Reserva () : libres(0), vivos(0) {}
+		~Reserva ();
+	};
+
+	static Reserva& Estado ();
+
+   /**
+  	* @brief Pide un bloque nuevo y encadena sus huecos en la lista de libres
+  	*/
+	static void NuevoBloque ( Reserva& r );
+
+public:
+	static const bool seguro_hilos = false;
+
+	static N* Reservar ();
+
+	static void Liberar ( N* n );
+
+   /**
+  	* @brief Numero de bloques pedidos al sistema hasta el momento
+  	*/
+	static size_t Bloques () {
+		return Estado().bloques.size();
+	}
+
+   /**
+  	* @brief Bytes de los huecos libres de todos los bloques
+  	*/
+	static size_t Holgura () {
+		Reserva &r = Estado();
+		return ( r.bloques.size() * NODOS_BLOQUE - r.vivos ) * sizeof(Hueco);
+	}
+};
+
+#include "AsignadorNodos.cpp"
+#endif
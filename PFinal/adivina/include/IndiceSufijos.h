@@ -0,0 +1,158 @@
+#ifndef __IndiceSufijos_h__
+#define __IndiceSufijos_h__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <utility>
+
+using namespace std;
+
+
+/**
+ * @file IndiceSufijos.h
+ * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+ * @date 24/01/2017
+ * @brief Fichero cabecera del TDA IndiceSufijos: array de sufijos de un
+ *        conjunto de textos para buscar subcadenas sin recorrerlos
+ */
+
+
+class IndiceSufijos {
+
+/**
+ * @page T.D.A. IndiceSufijos
+ *
+ * @section esIndiceSufijos Conjunto Especificacion
+ * Una instancia \e a del tipo de dato abstracto IndiceSufijos es un indice
+ * de solo lectura sobre una secuencia de textos t0, t1, ..., tn-1 que dice
+ * donde aparece una subcadena cualquiera.
+ *
+ * @section invIndiceSufijos Invariante de la representación
+ *
+ *  - corpus = t0 + '\\n' + t1 + '\\n' + ... + tn-1 + '\\n'. Ningun texto
+ *    contiene '\\n', por lo que ninguna subcadena sin '\\n' cruza dos textos
+ *  - sufijos es una permutacion de 0..corpus.size()-1 tal que los sufijos
+ *    corpus.substr(sufijos[i]) estan en orden creciente
+ *  - inicio[k] es la posicion de tk en corpus; inicio es creciente
+ *  - niveles es una matriz de ondiculas (wavelet matrix) de la secuencia
+ *    Texto(sufijos[0]), ..., Texto(sufijos[N-1]), con un nivel por bit del
+ *    numero de texto, del mas significativo al menos. En el nivel l la
+ *    secuencia esta ordenada de forma estable por sus l primeros bits
+ *    invertidos: niveles[l].bits tiene el bit l de cada elemento y
+ *    niveles[l].ceros cuantos de ellos son 0, que van delante en el nivel l+1
+ *
+ * @section faIndiceSufijos Función de abstracción
+ *
+ *  fa(rep) = { corpus.substr(inicio[k], inicio[k+1] - inicio[k] - 1) : 0 <= k < n }
+ */
+
+private:
+
+  /**
+   * @brief Nivel de la matriz de ondiculas: un bit por sufijo
+   */
+  struct Nivel {
+    vector<uint64_t> bits;      /**< Bits del nivel, 64 por palabra */
+    vector<unsigned> unos;      /**< Bits a 1 en las palabras anteriores a cada una */
+    int ceros;                  /**< Numero de bits a 0 del nivel */
+
+    /**
+     * @brief Numero de bits a 1 en las posiciones [0, i)
+     */
+    int Rango(int i) const {
+      int w = i >> 6, r = i & 63;
+      return unos[w] + ( r == 0 ? 0 : __builtin_popcountll(bits[w] << (64 - r)) );
+    }
+  };
+
+  string corpus;          /**< Textos seguidos, cada uno terminado en '\n' */
+  vector<int> sufijos;    /**< Array de sufijos de corpus */
+  vector<int> inicio;     /**< Posicion de cada texto en corpus */
+  vector<Nivel> niveles;  /**< Texto de cada sufijo, por bits (ver invariante) */
+
+  /**
+   * @brief Texto al que pertenece una posicion del corpus
+   * @param pos : posicion en corpus
+   * @return El k tal que tk contiene pos: O(log n)
+   */
+  int Texto(int pos) const;
+
+  /**
+   * @brief Menor texto de un intervalo del array de sufijos que no es menor
+   *        que uno dado
+   * @param l : nivel de la matriz en que se busca
+   * @param a, b : intervalo [a, b) de posiciones en el nivel l
+   * @param valor : bits de los textos del intervalo ya fijados por los
+   *        niveles anteriores
+   * @param desde : cota inferior, o -1 si cualquier texto sirve
+   * @return El texto buscado, o -1 si no hay ninguno
+   * @note Baja una vez por los bits de desde y, como mucho, otra por el
+   *       camino mas a la izquierda: O(log n)
+   */
+  int Siguiente(int l, int a, int b, int valor, int desde) const;
+
+public:
+
+  /**
+   * @brief Construye el indice de una secuencia de textos
+   * @param textos : textos a indexar, sin '\\n'. Se identifican por su posicion
+   * @note Ordena los sufijos por duplicacion de prefijos: O(N log^2 N) para un
+   *       corpus de N caracteres
+   */
+  void Construye(const vector<string> &textos);
+
+  /**
+   * @brief Vacia el indice
+   */
+  void clear();
+
+  /**
+   * @brief Intervalo del array de sufijos que empieza por un patron
+   * @param patron : subcadena buscada, no vacia
+   * @return [a, b) tal que los sufijos a..b-1 empiezan por patron
+   * @note Dos busquedas binarias comparando m caracteres: O(m log N)
+   */
+  pair<int, int> Intervalo(const string &patron) const;
+
+  /**
+   * @brief Numero de veces que aparece un patron en todos los textos
+   * @param patron : subcadena buscada
+   * @return El numero de apariciones, sin recorrerlas: O(m log N)
+   */
+  int Cuenta(const string &patron) const;
+
+  /**
+   * @brief Primer texto, a partir de uno dado, que contiene un patron
+   * @param patron : subcadena buscada
+   * @param desde : primer texto que se mira
+   * @return El menor k >= desde tal que tk contiene patron, o -1 si no hay
+   * @note Busca el intervalo del patron y en el, con la matriz de ondiculas,
+   *       el menor texto desde \e desde: O(m log N + log n), sin recorrer
+   *       las apariciones. Recorrer todos los textos que contienen el
+   *       patron, uno tras otro, cuesta lo mismo por cada uno
+   */
+  int Primero(const string &patron, int desde) const;
+
+  /**
+   * @brief Numero de textos indexados
+   */
+  int size() const { return inicio.size(); }
+
+  /**
+   * @brief Numero de caracteres del corpus, separadores incluidos
+   */
+  int Caracteres() const { return corpus.size(); }
+
+  /**
+   * @brief Bytes reservados por el corpus y los arrays del indice
+   */
+  size_t Bytes() const {
+    size_t b = corpus.capacity() + 1 + (sufijos.capacity() + inicio.capacity()) * sizeof(int);
+    for ( size_t l = 0 ; l < niveles.size() ; l++ )
+      b += niveles[l].bits.capacity() * sizeof(uint64_t) + niveles[l].unos.capacity() * sizeof(unsigned);
+    return b;
+  }
+};
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef __LectorLineas_h__
+#define __LectorLineas_h__
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+
+/**
+ * @file LectorLineas.h
+ * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+ * @date 24/01/2017
+ * @brief Fichero cabecera del lector de lineas con el que se cargan los
+ *        refranes de cualquier representacion
+ */
+
+
+class LectorLineas {
+
+/**
+ * @page T.D.A. LectorLineas
+ *
+ * @section esLectorLineas Conjunto Especificacion
+ * Una instancia \e a del tipo de dato abstracto LectorLineas recorre las
+ * lineas no vacias de un flujo, ya limpias: sin '\\r', espacios ni
+ * tabuladores al final y, si se pide, en minuscula y sin acentos (ver Utf8).
+ *
+ * Lee el flujo por bloques de TAM_BLOQUE caracteres directamente de su
+ * streambuf y copia cada linea en una misma cadena, que solo se amplia
+ * cuando aparece una linea mas larga que todas las anteriores. El flujo se
+ * consume hasta el final, aunque no se pidan todas las lineas.
+ */
+
+private:
+
+  static const size_t TAM_BLOQUE = 1 << 16;
+
+  istream &is;            /**< Flujo del que se leen las lineas */
+  vector<char> bloque;    /**< Ultimo bloque leido del flujo */
+  size_t pos;             /**< Siguiente caracter de bloque por mirar */
+  size_t fin;             /**< Numero de caracteres validos de bloque */
+  string linea;           /**< Ultima linea leida, reutilizada */
+  bool minusculas;        /**< Indica si las lineas se pasan a minuscula */
+  bool acentos;           /**< Indica si las lineas conservan los acentos */
+  size_t leidos;          /**< Caracteres leidos del flujo hasta el momento */
+
+  /**
+   * @brief Lee el siguiente bloque del flujo
+   * @return false si el flujo se ha terminado
+   */
+  bool Rellenar();
+
+public:
+
+  /**
+   * @brief Constructor
+   * @param entrada : flujo del que se leen las lineas
+   * @param minusc : si es true, las lineas se pasan a minuscula, incluidas las
+   *        mayusculas acentuadas en UTF-8 (ver Utf8 :: Minusculas)
+   * @param sin_acentos : si es true, se quitan los acentos (ver Utf8 :: QuitaAcentos)
+   */
+  LectorLineas(istream &entrada, bool minusc = false, bool sin_acentos = false);
+
+  /**
+   * @brief Avanza a la siguiente linea no vacia
+   * @return false si no quedan lineas; entonces el flujo queda en eof
+   */
+  bool Siguiente();
+
+  /**
+   * @brief Ultima linea leida por Siguiente
+   * @note La referencia sigue siendo valida, pero su contenido cambia, en la
+   *       siguiente llamada a Siguiente
+   */
+  const string & Linea() const { return linea; }
+
+  /**
+   * @brief Numero de caracteres leidos del flujo, saltos de linea incluidos
+   */
+  size_t Leidos() const { return leidos; }
+};
+
+
+/**
+ * @brief Carga en un conjunto de refranes las lineas de un flujo
+ * @param is : flujo con un refran por linea
+ * @param R : conjunto de refranes; cualquier tipo con Insertar(const string&),
+ *        como Refranes, RefranesRadix o la version con tabla hash
+ * @param minusculas : si es true los refranes se pasan a minuscula al leerlos
+ * @param sin_acentos : si es true se les quitan los acentos, de forma que
+ *        "el que rie el ultimo" y "el que ríe el último" son el mismo refran
+ * @return is, en estado eof
+ * @note Es la lectura de los operator>> de todas las representaciones
+ */
+template <class R>
+istream & LeeRefranes ( istream &is, R &refranes, bool minusculas = false, bool sin_acentos = false ) {
+
+  LectorLineas lector(is, minusculas, sin_acentos);
+
+  while ( lector.Siguiente() )
+    refranes.Insertar(lector.Linea());
+
+  return is;
+}
+
+#endif
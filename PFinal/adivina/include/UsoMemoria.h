@@ -0,0 +1,86 @@
+#ifndef __UsoMemoria_h__
+#define __UsoMemoria_h__
+
+#include <cstddef>
+#include <string>
+
+using namespace std;
+
+
+/**
+ * @file UsoMemoria.h
+ * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+ * @date 24/01/2017
+ * @brief Fichero cabecera del desglose de la memoria que ocupa un conjunto
+ *        de refranes (ver ArbolGeneral::MemoryUsage, Refranes::MemoryUsage)
+ */
+
+
+/**
+ * @brief Bytes ocupados por una estructura, por categorias
+ *
+ * Cada byte se cuenta en una sola categoria, de forma que Total() es la
+ * memoria ocupada. No se cuenta la cabecera que añade malloc a cada bloque,
+ * que depende de la biblioteca.
+ */
+struct UsoMemoria {
+  size_t nodos;       /**< Nodos sin su etiqueta: punteros, anotaciones y relleno */
+  size_t en_linea;    /**< Objetos etiqueta dentro de los nodos; en un string
+                           incluye las cadenas cortas guardadas en el propio objeto */
+  size_t heap;        /**< Caracteres de las etiquetas reservados fuera del nodo
+                           (capacidad + '\0'), solo en las cadenas largas */
+  size_t cubetas;     /**< Array de cubetas de una tabla hash */
+  size_t holgura;     /**< Nodos reservados por la estructura que no guardan nada,
+                           como los reciclados de un arbol. No incluye los
+                           huecos del asignador, comunes a todos los arboles
+                           (ver ArbolGeneral::HolguraAsignador) */
+  size_t auxiliares;  /**< Copias e indices: arbol congelado, indice de subcadenas... */
+  int cadenas_heap;   /**< Numero de etiquetas con los caracteres en el heap */
+
+  UsoMemoria () : nodos(0), en_linea(0), heap(0), cubetas(0), holgura(0),
+                  auxiliares(0), cadenas_heap(0) {}
+
+  /**
+   * @brief Memoria total, suma de todas las categorias
+   */
+  size_t Total () const {
+    return nodos + en_linea + heap + cubetas + holgura + auxiliares;
+  }
+
+  /**
+   * @brief Suma el desglose de otra estructura
+   */
+  UsoMemoria & operator+= ( const UsoMemoria &u ) {
+    nodos += u.nodos;
+    en_linea += u.en_linea;
+    heap += u.heap;
+    cubetas += u.cubetas;
+    holgura += u.holgura;
+    auxiliares += u.auxiliares;
+    cadenas_heap += u.cadenas_heap;
+    return *this;
+  }
+};
+
+
+/**
+ * @brief Bytes reservados fuera del objeto por una etiqueta
+ * @note Los tipos sin memoria dinamica no reservan nada
+ */
+template <class T>
+inline size_t MemoriaExterna ( const T& ) {
+  return 0;
+}
+
+/**
+ * @brief Bytes reservados fuera del objeto por una cadena
+ * @return 0 si los caracteres estan en el propio objeto (cadena corta), o
+ *         su capacidad mas el '\0' si estan en el heap
+ */
+inline size_t MemoriaExterna ( const string &s ) {
+  const char *objeto = reinterpret_cast<const char*>(&s);
+  bool en_linea = s.data() >= objeto && s.data() < objeto + sizeof(string);
+  return en_linea ? 0 : s.capacity() + 1;
+}
+
+#endif
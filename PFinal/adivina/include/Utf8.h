@@ -0,0 +1,60 @@
+#ifndef __Utf8_h__
+#define __Utf8_h__
+
+#include <string>
+
+using namespace std;
+
+
+/**
+ * @file Utf8.h
+ * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+ * @date 24/01/2017
+ * @brief Fichero cabecera de las funciones para recorrer por letras los
+ *        refranes escritos en UTF-8
+ *
+ * Una letra es un punto de codigo seguido de las marcas diacriticas que lo
+ * acompañen (U+0300 a U+036F), de forma que "é" cuenta como una sola letra
+ * tanto si esta compuesta (U+00E9) como si no ('e' seguida de U+0301).
+ * Los bytes que no forman UTF-8 valido cuentan como una letra cada uno.
+ */
+
+
+class Utf8 {
+public:
+
+  /**
+   * @brief Numero de bytes de la letra que empieza en una posicion
+   * @param cad : cadena en UTF-8
+   * @param pos : posicion del primer byte de la letra, pos < cad.size()
+   * @return Bytes del punto de codigo y de sus marcas diacriticas
+   */
+  static size_t LongitudLetra(const string &cad, size_t pos);
+
+  /**
+   * @brief Numero de letras de una cadena
+   * @param cad : cadena en UTF-8
+   * @param maximo : se deja de contar al llegar a este numero
+   * @return min(letras de cad, maximo)
+   */
+  static int Letras(const string &cad, int maximo);
+
+  /**
+   * @brief Pasa una cadena a minuscula
+   * @param cad : cadena en UTF-8, que se modifica
+   * @note Cambia A-Z y las mayusculas de U+00C0 a U+00DE (À, É, Ñ, Ç...),
+   *       que en UTF-8 ocupan lo mismo que sus minusculas
+   */
+  static void Minusculas(string &cad);
+
+  /**
+   * @brief Quita los acentos y diacriticos de las letras latinas
+   * @param cad : cadena en UTF-8, que se modifica
+   * @note "á", "è", "ü", "ç"... pasan a su letra sin acento y se eliminan las
+   *       marcas diacriticas sueltas. La "ñ" se conserva, porque en español
+   *       es una letra distinta de la "n"
+   */
+  static void QuitaAcentos(string &cad);
+};
+
+#endif
@@ -3,8 +3,12 @@
 
 
 #include "ArbolGeneral.h"
+#include "ArbolPlano.h"
+#include "IndiceSufijos.h"
 #include <fstream>
 #include <iostream>
+#include <random>
+#include <vector>
 
 using namespace std;
 
@@ -44,6 +48,8 @@ class Refranes {
  *
  * 	- No hay refranes repetidos
  *	- Los refranes estan en minuscula
+ *	- Cada letra del prefijo es un caracter UTF-8 completo con sus marcas diacriticas (ver Utf8.h),
+ *	  no un byte: una etiqueta de letra puede ocupar de 1 a varios bytes
  *	- El arbol tiene tantos niveles como indique len_prefijo+1
  *	- Si len_prefijo = 1 => El primer nivel, el nivel 0, se correspondera a la primera letra de cada refran
  *	- Si 2 refranes empiezan por la misma letra, el resto de ambos refranes ira a un nodo 
@@ -52,6 +58,11 @@ class Refranes {
  *	  del siguiente nivel. Y asi sucesivamente.
  *	- Los nodos hoja contendran las cadenas correspondientes al resto del refran, tras haberle quitado
  *	  las letras que indique len_prefijo.
+ *	- Los hijos de cada nodo estan ordenados por su etiqueta, de forma que los refranes se
+ *	  recorren en orden alfabetico y cada busqueda se detiene en cuanto pasa la etiqueta buscada.
+ *	- Con umbral > 0 (ver Umbral) o tras Optimiza una rama puede dejar de dividirse antes de
+ *	  len_prefijo letras: sus hijos son entonces las hojas, con el resto del refran desde esa
+ *	  profundidad. Los hijos de un nodo son o todos hojas (un cubo) o todos letras.
  *
  *
  * @section faRefranes Función de abstracción
@@ -63,12 +74,142 @@ class Refranes {
  *
  */
 
+public:
+
+  /**
+   * @brief Tipo del arbol de refranes. Cada nodo guarda su profundidad y el
+   *        numero de hojas (refranes) de su subarbol, ver ConAnotaciones.
+   *        Los nodos que se borran se reciclan en el propio arbol para las
+   *        siguientes inserciones (ver ArbolGeneral::Reciclar)
+   */
+  typedef ArbolGeneral<string, AsignadorHeap, ConAnotaciones> Arbol;
+
 private:
 
-  ArbolGeneral<string> ab;  /**< Arbol para almacenar los refranes */
+  Arbol ab;                 /**< Arbol para almacenar los refranes */
   int len_prefijo;          /**< Longitud del prefijo para construir el arbol */
   int n_ref;                /**< Numero de refranes */
   int caracteres_totales;   /**< Numero de caracteres totales */
+  int umbral;               /**< Refranes que caben en una rama sin dividirla, ver Umbral */
+  ArbolPlano<string> plano; /**< Copia aplanada de ab, solo valida si congelado */
+  bool congelado;           /**< Indica si plano refleja el contenido de ab */
+  IndiceSufijos indice;     /**< Array de sufijos de los refranes, en el orden de begin() */
+  bool indexado;            /**< Indica si se usa indice para buscar subcadenas */
+  bool indice_al_dia;       /**< Indica si indice refleja el contenido de ab */
+
+  /**
+   * @brief Descarta la copia aplanada y el indice de subcadenas tras modificar
+   *        el arbol. El indice se vuelve a construir en la siguiente busqueda
+   */
+  void Descongelar();
+
+  /**
+   * @brief Construye el indice de subcadenas si esta activado y no esta al dia
+   */
+  void ActualizaIndice();
+
+  /**
+   * @brief Posicion de un refran en el orden de begin()
+   * @param hoja : hoja del refran
+   * @return Su posicion, empezando en 0. Es la inversa de RefranK
+   * @note Suma los refranes de los hermanos izquierda de cada antecesor
+   */
+  int Orden(Arbol :: Nodo hoja) const;
+
+  /**
+   * @brief Baja por el arbol siguiendo las letras del prefijo de un refran
+   * @param refran : refran cuyo prefijo se busca
+   * @param encontrados : numero de letras del prefijo que ya estan en el arbol
+   * @param pos : bytes de refran que ocupan esas letras
+   * @return El nodo de la ultima letra encontrada (la raiz si no hay ninguna)
+   * @note En cada nivel solo se miran los hijos del nodo anterior, de forma que
+   *       el coste es O(len_prefijo * letras distintas)
+   */
+  Arbol :: Nodo BuscaPrefijo(const string &refran, int &encontrados, size_t &pos) const;
+
+  /**
+   * @brief Busca la hoja de un refran
+   * @param refran : refran completo
+   * @return Su hoja, o 0 si no esta. Es la busqueda de Esta
+   */
+  Arbol :: Nodo BuscaHoja(const string &refran) const;
+
+  /**
+   * @brief Busca una etiqueta entre los hijos de un nodo
+   * @param padre : nodo cuyos hijos se recorren
+   * @param etiqueta : etiqueta buscada
+   * @param anterior : al terminar, el ultimo hijo con etiqueta menor, o 0 si no
+   *        hay ninguno. Es el nodo tras el que habria que insertar la etiqueta
+   * @return El hijo con esa etiqueta, o 0 si no hay ninguno
+   * @note Los hijos de cada nodo estan ordenados, por lo que la busqueda se
+   *       detiene en el primero que no es menor que la etiqueta
+   */
+  Arbol :: Nodo Hijo(Arbol :: Nodo padre, const string &etiqueta, Arbol :: Nodo &anterior) const;
+
+  /**
+   * @brief Busca entre los hijos de un nodo la etiqueta igual a un trozo de
+   *        una cadena, sin copiarlo
+   * @param padre : nodo cuyos hijos se recorren
+   * @param cad : cadena que contiene la etiqueta buscada
+   * @param pos : posicion de cad donde empieza la etiqueta
+   * @param n : bytes de la etiqueta
+   * @param anterior : como en Hijo(padre, etiqueta, anterior)
+   * @return El hijo con etiqueta cad.substr(pos, n), o 0 si no hay ninguno
+   */
+  Arbol :: Nodo Hijo(Arbol :: Nodo padre, const string &cad, size_t pos, size_t n, Arbol :: Nodo &anterior) const;
+
+  /**
+   * @brief Primera hoja, en preorden, del subarbol de un nodo
+   * @param n : nodo con hijos
+   */
+  Arbol :: Nodo PrimeraHoja(Arbol :: Nodo n) const;
+
+  /**
+   * @brief Primera hoja, en preorden, tras el subarbol de un nodo
+   * @param n : nodo del arbol
+   * @return La hoja, o 0 si el subarbol de n llega hasta el final
+   * @note Sube hasta el primer antecesor con hermano derecha: O(profundidad)
+   */
+  Arbol :: Nodo HojaTras(Arbol :: Nodo n) const;
+
+  /**
+   * @brief Indica si las hojas de un nodo cuelgan directamente de el
+   * @param n : nodo devuelto por BuscaPrefijo
+   * @return true si sus hijos son hojas (o le corresponderian, si no tiene)
+   */
+  bool Cubo(Arbol :: Nodo n) const;
+
+  /**
+   * @brief Divide un cubo que ha superado el umbral por su siguiente letra
+   * @param n : nodo cuyos hijos son hojas, a menos de len_prefijo letras de la raiz
+   */
+  void Reparte(Arbol :: Nodo n);
+
+  /**
+   * @brief Cuelga de un nodo los refranes de un rango ordenado
+   * @param n : nodo del arbol, sin hijos, a profundidad d
+   * @param d : letras del prefijo que representa n
+   * @param pos : byte donde empieza la letra del nivel d en las cadenas [a,b),
+   *        que comparten los bytes anteriores
+   * @param refranes : cadenas ordenadas
+   * @param a, b : rango [a,b) de refranes que cuelgan de n
+   * @param optimo : si es true cada rama se divide solo si eso reduce Coste; si es
+   *        false se divide cuando tiene mas de umbral refranes
+   */
+  void Construye(Arbol :: Nodo n, int d, size_t pos, const vector<string> &refranes, size_t a, size_t b, bool optimo);
+
+  /**
+   * @brief Nodos mas caracteres minimos para colgar un rango de refranes de un nodo
+   * @param d, pos, refranes, a, b : como en Construye
+   * @return El coste de la mejor disposicion de la rama, sin contar el nodo
+   */
+  int Coste(int d, size_t pos, const vector<string> &refranes, size_t a, size_t b) const;
+
+  /**
+   * @brief Vuelve a construir el arbol con los mismos refranes
+   * @param optimo : como en Construye
+   */
+  void Reconstruye(bool optimo);
        
 public:
   /**
@@ -80,12 +221,53 @@ public:
    * @brief Constructor por parametros. Inicia len_prefijo al valor lpre 
    */
   Refranes (int lpre);
+
+  /**
+   * @brief Constructor con prefijo adaptativo
+   * @param lpre : numero maximo de letras del prefijo
+   * @param u : umbral, ver Umbral
+   */
+  Refranes (int lpre, int u);
   
   /** 
    * @brief devuelve el prefijo de refranes
    * @return el prefijo
    */
   int getLen_prefijo () const { return len_prefijo; }       
+
+  /**
+   * @brief Devuelve el umbral de division de las ramas
+   * @return Cuantos refranes puede tener una rama sin dividirse por su siguiente
+   *         letra. Con 0 (por defecto) todas las ramas llegan a len_prefijo letras
+   */
+  int Umbral () const { return umbral; }
+
+  /**
+   * @brief Cambia el umbral de division de las ramas y reorganiza el arbol
+   * @param u : nuevo umbral. Una rama con mas de u refranes se divide por su
+   *        siguiente letra, hasta un maximo de len_prefijo letras; con u o menos,
+   *        sus refranes cuelgan de ella con el resto de sus letras
+   * @note Las ramas densas llegan asi a mas letras y las dispersas se quedan
+   *       en pocos nodos. Al insertar, un cubo que supera el umbral se divide;
+   *       al borrar no se vuelven a juntar
+   */
+  void Umbral (int u);
+
+  /**
+   * @brief Reorganiza el arbol para que tenga el minimo de nodos mas caracteres
+   * @note Cada rama, de abajo arriba, se divide por su siguiente letra solo si
+   *       eso reduce Numero_Nodos() + Caracteres_Almacenados(), sin pasar de
+   *       len_prefijo letras: O(N * len_prefijo^2). Las inserciones posteriores
+   *       siguen la regla del umbral en la rama que tocan
+   */
+  void Optimiza();
+
+  /**
+   * @brief Devuelve la disposicion elegida para el arbol
+   * @return Para cada rama cuyos hijos son hojas, en orden alfabetico, su
+   *         prefijo y el numero de refranes que cuelgan de ella
+   */
+  vector< pair<string, int> > Disposicion() const;
   
   /** 
    * @brief devuelve el numero de refranes alamacenados
@@ -96,16 +278,29 @@ public:
   /** 
    * @brief Inserta un refran en el conjunto 
    * @param refran : refran a insertar
-   * @note el numero de refranes se incrementa en uno mas
+   * @note el numero de refranes se incrementa en uno mas, salvo que ya estuviera
+   *       o que tenga menos letras que len_prefijo, en cuyo caso no se inserta
    */
   void Insertar(const string &refran);
   
   /** 
    * @brief Borra un refrán en el conjunto 
    * @param refran : refran a borrar
-   * @note el numero de refranes se decrementa en uno mas
+   * @note el numero de refranes se decrementa en uno mas, si estaba. La hoja
+   *       se busca como en Esta, pero sin construir un iterador ni copiar
+   *       letras, y se quitan ella y los antecesores que se quedan sin hijos:
+   *       O(len_prefijo + hermanos). Sus nodos se guardan en el arbol para
+   *       las siguientes inserciones
    */
   void BorrarRefran(const string &refran);
+
+  /** 
+   * @brief Borra varios refranes del conjunto 
+   * @param refranes : refranes a borrar; los que no esten se ignoran
+   * @return El numero de refranes borrados
+   * @note Cada refran se busca por su prefijo, sin recorrer los demas
+   */
+  int BorrarRefranes(const vector<string> &refranes);
   
   // Declaracion adelantada de los iteradores de refranes
   class iterator; 
@@ -113,15 +308,156 @@ public:
   
   /** 
    * @brief Devuelve si un refran esta en el conjunto. Si esta devuelve un iterador a el
-   * @param refran : refran a buscar
+   * @param refran : refran a buscar, completo
    * @return una pareja que contiene si el refran esta y en caso afirmativo un iterador a el
+   * @note Solo cuenta la coincidencia exacta. Baja por las letras del prefijo y compara
+   *       el resto con las hojas de ese nodo: O(len_prefijo + hermanos)
    */
   pair<bool, iterator> Esta(const string &refran);
+
+  /** 
+   * @brief Version constante de Esta
+   * @note Como todas las consultas const, no modifica nada del conjunto, por
+   *       lo que varios hilos la pueden usar a la vez mientras ninguno lo
+   *       modifique (ver RefranesCompartidos)
+   */
+  pair<bool, const_iterator> Esta(const string &refran) const;
+
+  /** 
+   * @brief Busca el primer refran que contiene una subcadena
+   * @param patron : subcadena a buscar
+   * @return una pareja que contiene si algun refran contiene el patron y en caso
+   *         afirmativo un iterador al primero
+   * @note Recorre todos los refranes: O(N*L), salvo con IndexaSubcadenas
+   */
+  pair<bool, iterator> BuscaSubcadena(const string &patron);
+
+  /** 
+   * @brief Busca el primer refran que contiene una subcadena a partir de uno dado
+   * @param patron : subcadena a buscar
+   * @param desde : primer refran que se mira
+   * @return una pareja que contiene si algun refran desde \e desde contiene el patron
+   *         y en caso afirmativo un iterador al primero
+   */
+  pair<bool, iterator> BuscaSubcadena(const string &patron, iterator desde);
+
+  /** 
+   * @brief Activa o desactiva el indice de subcadenas
+   * @param activo : si es true, BuscaSubcadena y CuentaSubcadena usan un array
+   *        de sufijos de todos los refranes (ver IndiceSufijos) en lugar de
+   *        recorrerlos
+   * @note El indice ocupa unos 5 bytes por caracter, y 1,5 bits mas por
+   *       caracter y por cada bit del numero de refranes. Se construye en la
+   *       primera busqueda y se vuelve a construir en la primera tras
+   *       cualquier insercion o borrado: O(N log^2 N)
+   */
+  void IndexaSubcadenas(bool activo = true);
+
+  /** 
+   * @brief Indica si el indice de subcadenas esta activado
+   */
+  bool Indexado() const { return indexado; }
+
+  /** 
+   * @brief Cuenta cuantas veces aparece una subcadena en todos los refranes
+   * @param patron : subcadena a buscar
+   * @return El numero de apariciones (varias en un mismo refran cuentan por separado)
+   * @note Con el indice activado es O(m log N) sin recorrer las apariciones;
+   *       sin el, recorre todos los refranes
+   */
+  int CuentaSubcadena(const string &patron);
+
+  /** 
+   * @brief Version constante de CuentaSubcadena
+   * @note Usa el indice solo si ya esta al dia (ver PreparaLectura); si no,
+   *       recorre los refranes en lugar de construirlo
+   */
+  int CuentaSubcadena(const string &patron) const;
+
+  /** 
+   * @brief Deja construido todo lo que las consultas construyen la primera vez
+   * @note Tras llamarla, y hasta la siguiente modificacion, las consultas
+   *       const usan el indice de subcadenas igual que las demas
+   */
+  void PreparaLectura();
   
+  /** 
+   * @brief Devuelve el refran que ocupa una posicion
+   * @param k : posicion del refran, empezando en 0, en el orden de begin()
+   * @return Un iterador al refran k-esimo
+   * @pre 0 <= k < size()
+   * @note Baja desde la raiz usando el numero de refranes de cada rama, sin
+   *       recorrer los refranes anteriores
+   */
+  iterator RefranK(int k);
+
+  /** 
+   * @brief Version constante de RefranK
+   */
+  const_iterator RefranK(int k) const;
+
+  /** 
+   * @brief Elige un refran al azar, todos con la misma probabilidad
+   * @param gen : generador de <random> del llamador (p.ej. mt19937), que se
+   *        siembra una sola vez
+   * @return Un iterador constante al refran elegido
+   * @pre size() > 0
+   * @note Sortea su posicion y va a ella con RefranK: el coste depende de la
+   *       altura del arbol y del numero de hijos de cada nodo, no del numero
+   *       de refranes. Varios hilos lo pueden usar a la vez, cada uno con su
+   *       generador
+   */
+  template <class RNG>
+  const_iterator Aleatorio(RNG &gen) const {
+    uniform_int_distribution<int> dist(0, n_ref - 1);
+    return RefranK(dist(gen));
+  }
+
+  class Rango;
+
+  /** 
+   * @brief Devuelve los refranes que empiezan por una cadena
+   * @param prefijo : principio de los refranes buscados; puede ser mas corto o
+   *        mas largo que len_prefijo
+   * @param limite : numero maximo de refranes del rango, o -1 para no limitarlo
+   * @return El rango de esos refranes, en orden alfabetico. Solo se componen
+   *         los refranes de sus extremos hasta que se recorre
+   * @note Baja por las letras del prefijo hasta su nodo, cuyas hojas son
+   *       consecutivas en el recorrido. Si el prefijo pasa de las letras del
+   *       arbol, se filtran las hojas de ese nodo, que tambien son consecutivas.
+   *       Coste O(len_prefijo + hermanos + limite), no O(N)
+   */
+  Rango ConPrefijo(const string &prefijo, int limite = -1) const;
+
   /** 
    * @brief Elimina todos los refranes 
    */
   void clear();
+
+  /**
+   * @brief Carga de una vez los refranes de un flujo ordenado, un refran por linea
+   * @param is : flujo de entrada, ordenado de menor a mayor (orden de string)
+   * @note Los refranes que habia se eliminan; len_prefijo se conserva. Cada linea
+   *       se compara con la mayor leida hasta el momento y solo se crean los nodos
+   *       desde la letra en que difieren, colgados a la derecha del camino
+   *       anterior: O(len_prefijo + longitud) por linea, sin buscar en el arbol.
+   *       Las lineas desordenadas o repetidas no rompen la carga: pasan por Insertar.
+   */
+  void BuildFromSorted(istream &is);
+
+  /**
+   * @brief Ordena un fichero de lineas que puede no caber en memoria
+   * @param entrada : fichero a ordenar
+   * @param salida : fichero donde se escriben las lineas ordenadas y sin repetir
+   * @param lineas_memoria : numero maximo de lineas que se ordenan en memoria a la vez
+   * @return true si se han podido leer y escribir todos los ficheros
+   * @note Ordena por tramos de lineas_memoria lineas que escribe en ficheros
+   *       temporales, con nombres nuevos junto a salida (salida.XXXXXX, ver
+   *       mkstemp), y despues los mezcla todos a la vez. Los temporales se
+   *       borran siempre, tambien si falla. Las lineas se limpian igual que al
+   *       leer los refranes.
+   */
+  static bool OrdenaFichero(const string &entrada, const string &salida, size_t lineas_memoria = 1000000);
   
   /** 
    * @brief Lectura/Escritura de un conjunto de refranes
@@ -132,8 +468,9 @@ public:
   /**
    * @brief Cuenta el numero total de los caracteres en todos los refranes
    * @return Devuelve el numero total de caracteres en todos los refranes
+   * @note Se lleva la cuenta al insertar y borrar: O(1)
    */  
-  int Caracteres_Refranes();
+  int Caracteres_Refranes() const;
   
   /**
    * @brief Cuenta el numero de caracteres usados
@@ -141,6 +478,26 @@ public:
    * @note que no tiene que conincide con el numero de caracteres de todos los refranes almancenados
    */
   int Caracteres_Almacenados();
+
+  /**
+   * @brief Cuenta los caracteres usados si las etiquetas que acaban igual
+   *        comparten el final, como en GuardaBinario(fichero, true)
+   * @return Los caracteres de un AlmacenColas con las etiquetas del arbol
+   * @note La diferencia con Caracteres_Almacenados es lo que ahorran las
+   *       colas compartidas ("...que ciento volando", las letras sueltas que
+   *       aparecen al final de alguna hoja). Construye el almacen: O(N log n)
+   */
+  int Caracteres_Colas();
+
+  /**
+   * @brief Memoria ocupada por el conjunto, por categorias
+   * @return El desglose del arbol (ver ArbolGeneral::MemoryUsage) y, como
+   *         auxiliares, la copia congelada y el indice de subcadenas
+   * @note A diferencia de Caracteres_Almacenados cuenta los bytes reales:
+   *         punteros y anotaciones de cada nodo, el objeto string de cada
+   *         etiqueta y la capacidad de las que no caben en el. O(N)
+   */
+  UsoMemoria MemoryUsage() const;
   
   /**
    * @brief Numero de nodos necesarios para la configuración
@@ -148,6 +505,39 @@ public:
    */
   int Numero_Nodos() const;
 
+  /**
+   * @brief Congela el conjunto para consultas de solo lectura
+   * @note Guarda una copia aplanada del arbol (ver ArbolGeneral::freeze), de forma
+   *       que Caracteres_Almacenados y Caracteres_Colas recorren memoria
+   *       contigua. Los iteradores y las busquedas siguen recorriendo el
+   *       arbol, asi que congelar no acelera el juego y solo gasta memoria.
+   *       Cualquier insercion o borrado posterior descarta la copia.
+   */
+  void freeze();
+
+  /**
+   * @brief Guarda el arbol de refranes en el formato binario de ArbolMapeado
+   * @param fichero : ruta del fichero a crear
+   * @param compartir_colas : si es true, las etiquetas se guardan en un
+   *        AlmacenColas y cada nodo solo apunta a su posicion en el
+   * @return true si se ha podido escribir
+   * @note CargaBinario lee igual los dos formatos
+   */
+  bool GuardaBinario(const string &fichero, bool compartir_colas = false) const;
+
+  /**
+   * @brief Carga los refranes de un fichero escrito con GuardaBinario
+   * @param fichero : ruta del fichero
+   * @return true si el fichero tiene un formato valido
+   * @note El fichero se proyecta en memoria y el arbol se reconstruye en una
+   *       sola pasada, sin analizar texto ni buscar cada refran. len_prefijo
+   *       se toma del fichero, salvo si no tiene refranes. Si los hijos no estan ordenados (ficheros de
+   *       versiones anteriores) los refranes se vuelven a insertar. Para solo
+   *       consultarlos, RefranesMapeados los lee de la proyeccion sin construir
+   *       ningun nodo.
+   */
+  bool CargaBinario(const string &fichero);
+
   
 
 /************************ ITERADORES ************************/
@@ -162,12 +552,14 @@ public:
 	class iterator {
   	private:
 
-	    ArbolGeneral<string> :: iter_preorden it;
+	    Arbol :: iter_preorden it;
 	    string cad;
+	    string prefijo;        // Etiquetas de los antecesores del nodo actual
+	    vector<size_t> marca;  // Longitud de prefijo en cada nivel, ver Avanzar
 
   	public:
-	    iterator() { cad="";}
-	    string & operator *();
+	    iterator() : marca(1, 0) { cad="";}
+	    const string & operator *() const;
 	    bool operator==(const iterator &i)const;
 	    bool operator!=(const iterator &i)const;   
 	    iterator &operator ++();
@@ -187,19 +579,57 @@ public:
 	class const_iterator {
   	private:
   
-	    ArbolGeneral<string> :: const_iter_preorden it;
+	    Arbol :: const_iter_preorden it;
 	    string cad;
+	    string prefijo;        // Etiquetas de los antecesores del nodo actual
+	    vector<size_t> marca;  // Longitud de prefijo en cada nivel, ver Avanzar
 	  
   	public:
 	    const_iterator();
 	    const_iterator(const iterator  &i);
-	    string & operator *();
+	    const string & operator *() const;
 	    bool operator==(const const_iterator &i)const;
 	    bool operator!=(const const_iterator &i)const;    
 	    const_iterator &operator ++();
 
 	   	friend class Refranes;
   	};	  
+
+  	/**
+  	 * @page T.D.A. Rango
+	 *
+	 * @section esRefranesRango Conjunto Especificacion
+	 * Una instancia \e a del tipo de dato abstracto Rango es una secuencia de
+	 * refranes consecutivos, [primero, ultimo), con un numero maximo de ellos.
+	 * Se recorre con begin y end, o con un for de rango
+  	 */
+	class Rango {
+  	private:
+
+	    Refranes :: const_iterator primero, ultimo;
+	    int limite;
+
+  	public:
+	    class iterator {
+	    private:
+	        Refranes :: const_iterator it, fin;
+	        int quedan; // refranes que faltan hasta el limite, -1 sin limite
+
+	    public:
+	        const string & operator *() const { return *it; }
+	        bool operator==(const iterator &i) const { return it == i.it; }
+	        bool operator!=(const iterator &i) const { return it != i.it; }
+	        iterator &operator ++();
+
+	        friend class Rango;
+	    };
+
+	    iterator begin() const;
+	    iterator end() const;
+	    bool empty() const { return limite == 0 || primero == ultimo; }
+
+	    friend class Refranes;
+	};
  
 
 
@@ -226,5 +656,12 @@ public:
 	 * @return Un iterador constante a una posicion siguiente al ultimo refran
 	 */       
 	const_iterator Cend() const;
+
+	/**
+	 * @brief Versiones constantes de begin y end, para recorrer un conjunto
+	 *        constante (p.ej. con un for de rango)
+	 */
+	const_iterator begin() const { return Cbegin(); }
+	const_iterator end() const { return Cend(); }
 };
 #endif
\ No newline at end of file
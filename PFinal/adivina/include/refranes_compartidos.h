@@ -0,0 +1,113 @@
+#ifndef __REFRANES_COMPARTIDOS__H
+#define __REFRANES_COMPARTIDOS__H
+
+
+#include "refranes.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+
+/**
+ * @file refranes_compartidos.h
+ * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+ * @date 26/01/2017
+ * @brief Fichero cabecera del TDA RefranesCompartidos: un conjunto de
+ *        refranes que leen varios hilos a la vez mientras otro lo modifica
+ */
+
+
+class RefranesCompartidos {
+
+/**
+ * @page T.D.A. RefranesCompartidos
+ *
+ * @section esRefranesCompartidos Conjunto Especificacion
+ * Una instancia \e a del tipo de dato abstracto RefranesCompartidos guarda
+ * la version actual de un conjunto de Refranes. Cada lector toma con Lector
+ * una instantanea, que no cambia mientras la conserve, y hace sobre ella
+ * las consultas const de Refranes (Esta, ConPrefijo, RefranK, Cbegin...)
+ * sin ningun bloqueo. El escritor no modifica la version actual: modifica
+ * una copia y la publica de una vez (Modificar), de forma que los lectores
+ * que llegan despues ven la nueva y los que ya estaban siguen con la suya.
+ *
+ * Las instantaneas que ya no son la actual se retiran y se destruyen desde
+ * Modificar, cuando ningun lector las conserva. Asi el coste de destruir una
+ * version, O(n), lo paga el escritor y no el lector que la suelta el ultimo.
+ *
+ * @section invRefranesCompartidos Invariante de la representación
+ *
+ *  - actual nunca es nulo y, tras Modificar, tiene el indice de subcadenas
+ *    al dia (ver Refranes::PreparaLectura)
+ *  - Ninguna version de retirados es la actual
+ */
+
+private:
+
+  shared_ptr<const Refranes> actual;            /**< Version que reciben los lectores */
+  vector< shared_ptr<const Refranes> > retirados; /**< Versiones anteriores aun en uso */
+  mutex escritura;                              /**< Serializa a los escritores */
+
+  /**
+   * @brief Publica una nueva version y retira la anterior
+   * @param nueva : version ya preparada para la lectura
+   * @pre El hilo tiene bloqueado escritura
+   */
+  void Publica(shared_ptr<const Refranes> nueva);
+
+  /**
+   * @brief Destruye las versiones retiradas que ningun lector conserva
+   * @pre El hilo tiene bloqueado escritura
+   */
+  void Recoge();
+
+public:
+
+  /**
+   * @brief Constructor
+   * @param inicial : refranes con los que empieza, se copian
+   */
+  RefranesCompartidos(const Refranes &inicial);
+
+  RefranesCompartidos(const RefranesCompartidos &) = delete;
+  RefranesCompartidos & operator=(const RefranesCompartidos &) = delete;
+
+  /**
+   * @brief Instantanea de la version actual, para consultarla
+   * @return Puntero compartido a un Refranes constante que no cambia
+   *         mientras se conserve
+   * @note Se puede llamar desde cualquier hilo a la vez que Modificar. El
+   *       lector debe soltarla antes de que se destruya este objeto
+   */
+  shared_ptr<const Refranes> Lector() const;
+
+  /**
+   * @brief Aplica una modificacion y la publica
+   * @param cambio : funcion que recibe un Refranes& y lo modifica; puede
+   *        hacer varios cambios, que se publican juntos
+   * @note Cada llamada copia entera la version actual (todos los nodos y
+   *       etiquetas: O(n) en tiempo y otra copia en memoria mientras haya
+   *       lectores de la anterior) y, si el indice de subcadenas esta
+   *       activado, lo vuelve a construir: O(N log^2 N). Ese coste no depende
+   *       del cambio, por lo que k inserciones en k llamadas cuestan k copias
+   *       y en una sola llamada, una. Los escritores se esperan entre si, los
+   *       lectores no esperan nunca
+   */
+  template <class F>
+  void Modificar(F cambio) {
+    lock_guard<mutex> bloqueo(escritura);
+    shared_ptr<Refranes> nueva(new Refranes(*Lector()));
+    cambio(*nueva);
+    nueva->PreparaLectura();
+    Publica(nueva);
+  }
+
+  /**
+   * @brief Numero de versiones retiradas que aun no se han destruido
+   */
+  int Retirados();
+};
+
+#endif
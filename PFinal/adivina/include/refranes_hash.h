@@ -6,7 +6,11 @@
 #include <iostream>
 #include <cmath>
 #include <unordered_set>
+#include <unordered_map>
 #include <functional>
+#include <random>
+#include <vector>
+#include "UsoMemoria.h"
 
 using namespace std;
 
@@ -48,6 +52,8 @@ class Refranes {
  *  - No hay refranes repetidos
  *  - Los refranes estan en minuscula
  *  - No habra 2 refranes con el mismo valor my_hash como clave
+ *  - posiciones tiene la direccion de cada refran de ab una sola vez
+ *  - indice[posiciones[i]] == i para cada posicion i
  *
  *
  *
@@ -67,7 +73,8 @@ private:
       private:
         unsigned int len;
       public:
-        my_hash (int l=3) { len= l; }
+        my_hash () { len = 3; }
+        my_hash (int l) { len = l; }
         void set_len (int l);
         size_t operator()( const string& clave )const;
     };   
@@ -75,6 +82,15 @@ private:
     unordered_set<string,my_hash> ab; /**< Tabla hash para almacenar los refranes */
     int n_ref;                        /**< Numero de refranes */
     int caracteres_totales;           /**< Numero de caracteres totales */ 
+    vector<const string*> posiciones; /**< Refranes de ab en un array, para Aleatorio. Los
+                                           nodos de la tabla no se mueven al crecer esta */
+    unordered_map<const string*, size_t> indice; /**< Posicion de cada refran en posiciones,
+                                                      para borrarlo sin buscarlo */
+
+    /**
+     * @brief Vuelve a llenar posiciones e indice con los refranes de ab
+     */
+    void Indexa();
     
     
 public:
@@ -82,6 +98,17 @@ public:
    * @brief Constructor por defecto. Inicia len_prefijo a 3
    */
   Refranes();      
+
+  /**
+   * @brief Constructor de copia
+   * @note posiciones apunta a los refranes de la copia, no a los de R
+   */
+  Refranes(const Refranes &R);
+
+  /**
+   * @brief Operador de asignacion, ver el constructor de copia
+   */
+  Refranes & operator=(const Refranes &R);
   
   /** 
    * @brief devuelve el numero de refranes alamacenados
@@ -99,9 +126,25 @@ public:
   /** 
    * @brief Borra un refrán en el conjunto 
    * @param refran : refran a borrar
-   * @note el numero de refranes se decrementa en uno mas
+   * @note el numero de refranes se decrementa en uno mas. Su hueco en
+   *       posiciones, que da indice, lo ocupa el ultimo: O(1) de media
    */
   void BorrarRefran(const string &refran);
+
+  /** 
+   * @brief Elige un refran al azar, todos con la misma probabilidad
+   * @param gen : generador de <random> del llamador (p.ej. mt19937), que se
+   *        siembra una sola vez
+   * @return El refran elegido. A diferencia de la version con arbol no se
+   *         devuelve un iterador: los de la tabla no sobreviven a un rehash
+   * @pre size() > 0
+   * @note O(1): sortea una posicion del array de refranes
+   */
+  template <class RNG>
+  const string & Aleatorio(RNG &gen) const {
+    uniform_int_distribution<size_t> dist(0, posiciones.size() - 1);
+    return *posiciones[dist(gen)];
+  }
   
   // Declaracion adelantada de los iteradores de refranes
   class iterator; 
@@ -130,6 +173,17 @@ public:
    * @return Devuelve el numero total de caracteres en todos los refranes
    */  
   int Caracteres_Refranes();
+
+  /**
+   * @brief Memoria ocupada por el conjunto, por categorias
+   * @return El array de cubetas como cubetas; el enlace y el hash guardado de
+   *         cada nodo de la tabla como nodos; su string como en_linea y la
+   *         capacidad de los refranes largos como heap (ver UsoMemoria). El
+   *         array de Aleatorio y su indice cuentan como auxiliares
+   * @note La disposicion de los nodos es la de libstdc++, que guarda el hash
+   *       de cada clave cuando la funcion hash no es trivial
+   */
+  UsoMemoria MemoryUsage() const;
     
     
     
@@ -0,0 +1,80 @@
+#ifndef __REFRANES_MAPEADOS__H
+#define __REFRANES_MAPEADOS__H
+
+
+#include "ArbolMapeado.h"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+
+/**
+ * @file refranes_mapeados.h
+ * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+ * @date 26/01/2017
+ * @brief Fichero cabecera del TDA RefranesMapeados: los refranes de un
+ *        fichero binario consultados directamente desde la proyeccion
+ */
+
+
+class RefranesMapeados {
+
+/**
+ * @page T.D.A. RefranesMapeados
+ *
+ * @section esRefranesMapeados Conjunto Especificacion
+ * Una instancia \e a del tipo de dato abstracto RefranesMapeados es el
+ * conjunto de refranes, de solo lectura, guardado con Refranes::GuardaBinario.
+ * A diferencia de Refranes::CargaBinario no se construye ningun arbol: las
+ * etiquetas se leen de la proyeccion del fichero (ver ArbolMapeado) y solo
+ * se reserva un entero por refran. Abrir un fichero cuesta una pasada por la
+ * tabla de nodos, sin analizar texto ni reservar nada por nodo.
+ *
+ * @section invRefranesMapeados Invariante de la representación
+ *
+ *  - hojas tiene, en preorden, las posiciones de las hojas de mapa sin
+ *    contar la raiz. El refran k es la concatenacion de las etiquetas del
+ *    camino de la raiz (sin ella) a hojas[k]
+ */
+
+private:
+
+  ArbolMapeado mapa;          /**< Fichero proyectado */
+  vector<int> hojas;          /**< Posicion en mapa de cada refran */
+
+public:
+
+  /**
+   * @brief Proyecta un fichero escrito con Refranes::GuardaBinario
+   * @param fichero : ruta del fichero
+   * @return true si el fichero tiene un formato valido (ver ArbolMapeado::Abrir)
+   */
+  bool Abrir(const string &fichero);
+
+  /**
+   * @brief Numero de refranes
+   */
+  int size() const { return hojas.size(); }
+
+  /**
+   * @brief Refran que ocupa una posicion, en el orden del fichero
+   * @param k : posicion del refran, 0 <= k < size()
+   * @note Sube por los padres de su hoja: O(len_prefijo)
+   */
+  string Refran(int k) const;
+
+  /**
+   * @brief Elige un refran al azar, todos con la misma probabilidad
+   * @param gen : generador de <random> del llamador, que se siembra una vez
+   * @pre size() > 0
+   */
+  template <class RNG>
+  string Aleatorio(RNG &gen) const {
+    uniform_int_distribution<int> dist(0, size() - 1);
+    return Refran(dist(gen));
+  }
+};
+
+#endif
@@ -0,0 +1,318 @@
+#ifndef __REFRANES_RADIX_H
+#define __REFRANES_RADIX_H
+
+
+#include "ArbolGeneral.h"
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+
+/**
+ * @file refranes_radix.h
+ * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+ * @date 19/01/2017
+ * @brief Fichero cabecera del TDA RefranesRadix, implementado a partir de
+ *        un Arbol General cuyas cadenas de nodos con un solo hijo se compactan
+ *        en una sola arista (arbol radix)
+ */
+
+
+/**
+ * @brief Trozo del almacen de caracteres de RefranesRadix que sirve de etiqueta
+ */
+struct Tramo {
+  unsigned int inicio;   /**< Posicion del primer caracter en el almacen */
+  unsigned int longitud; /**< Numero de caracteres de la etiqueta */
+};
+
+
+class RefranesRadix {
+
+/**
+ * @page T.D.A. RefranesRadix
+ *
+ * @section esRefranesRadix Conjunto Especificacion
+ * Una instancia \e a del tipo de dato abstracto RefranesRadix es la misma
+ * coleccion de refranes que Refranes, con el mismo len_prefijo, pero
+ * guardada de forma mas compacta. Como en Refranes, len_prefijo cuenta
+ * letras UTF-8 (ver Utf8), aunque las etiquetas y las profundidades se miden
+ * en bytes del almacen.
+ *
+ * Para poder usar el tipo de dato RefranesRadix se debe incluir el fichero
+ * <tt>\#include refranes_radix.h</tt>
+ *
+ * NOTA: Su representacion esta basada en un Arbol General cuyas etiquetas
+ * son trozos (Tramo) de un unico almacen de caracteres
+ *
+ * @section invRefranesRadix Invariante de la representación
+ *
+ *	- No hay refranes repetidos
+ *	- Cada nodo interno representa las letras de su etiqueta, que estan todas
+ *	  dentro de las len_prefijo primeras del refran. Su profundidad es la suma
+ *	  de las longitudes de las etiquetas desde la raiz, y nunca pasa de len_prefijo
+ *	- Las etiquetas empiezan y acaban en letras enteras: una letra con sus
+ *	  marcas diacriticas nunca se parte entre dos aristas
+ *	- Los nodos internos, salvo la raiz, tienen al menos dos hijos: un nodo de
+ *	  Refranes con un solo hijo se une a el en una sola arista
+ *	- Las hojas guardan el resto del refran desde la profundidad de su padre.
+ *	  Si el padre tiene profundidad menor que len_prefijo, la hoja es la unica
+ *	  de su rama y su etiqueta incluye las letras del prefijo que faltan
+ *	- Por debajo de profundidad len_prefijo los hijos empiezan por letras
+ *	  distintas; a profundidad len_prefijo solo hay hojas
+ *	- Los hijos de cada nodo estan ordenados por su primera letra, y las hojas
+ *	  a profundidad len_prefijo por su etiqueta entera
+ *
+ * @section faRefranesRadix Función de abstracción
+ *
+ *	Cada hoja h representa el refran formado por las etiquetas de sus
+ *	antecesores, desde la raiz, seguidas de la suya:
+ *
+ *	<br>fa(rep) = { almacen[Etiqueta(n)] ... almacen[Etiqueta(h)] : h hoja de rep.ab }</br>
+ */
+
+public:
+
+  /**
+   * @brief Tipo del arbol de refranes, con etiquetas en el almacen. Como en
+   *        Refranes, cada nodo guarda su profundidad (ver ConAnotaciones)
+   */
+  typedef ArbolGeneral<Tramo, AsignadorHeap, ConAnotaciones> Arbol;
+
+private:
+
+  Arbol ab;                 /**< Arbol para almacenar los refranes */
+  string almacen;           /**< Caracteres de todas las etiquetas, una tras otra */
+  int len_prefijo;          /**< Longitud del prefijo para construir el arbol */
+  int n_ref;                /**< Numero de refranes */
+  int caracteres_totales;   /**< Numero de caracteres totales */
+  size_t muertos;           /**< Caracteres del almacen que ya no usa ninguna etiqueta */
+
+  /**
+   * @brief Añade letras al almacen
+   * @param cad : cadena de la que se copian las letras
+   * @param desde : primera letra que se copia; se copian hasta el final
+   * @return El tramo del almacen con esas letras
+   */
+  Tramo Guarda(const string &cad, size_t desde);
+
+  /**
+   * @brief Bytes que ocupan las len_prefijo primeras letras de una cadena
+   * @param cad : cadena en UTF-8
+   * @return La posicion donde acaba el prefijo, o string::npos si cad tiene
+   *         menos de len_prefijo letras (ver Utf8)
+   */
+  size_t FinPrefijo(const string &cad) const;
+
+  /**
+   * @brief Copia al principio del almacen las letras que usan las etiquetas,
+   *        en preorden, y descarta las demas
+   * @note O(Caracteres_Almacenados() + Numero_Nodos())
+   */
+  void Compacta();
+
+  /**
+   * @brief Une un nodo con su unico hijo en una sola arista
+   * @param padre : nodo interno, distinto de la raiz, con un solo hijo
+   * @param unico : su hijo, que pasa a ocupar su sitio
+   */
+  void Une(Arbol :: Nodo padre, Arbol :: Nodo unico);
+
+  /**
+   * @brief Compara la etiqueta de un nodo con un trozo de cadena
+   * @param t : etiqueta del nodo
+   * @param cad : cadena
+   * @param desde : posicion de cad donde empieza la comparacion
+   * @return El numero de bytes de las letras enteras iguales desde el
+   *         principio de los dos
+   */
+  size_t Comunes(const Tramo &t, const string &cad, size_t desde) const;
+
+  /**
+   * @brief Compara la primera letra de una etiqueta con una letra de una cadena
+   * @param t : etiqueta del nodo, no vacia
+   * @param cad : cadena
+   * @param desde : posicion de cad donde empieza la letra, desde < cad.size()
+   * @return Menor, igual o mayor que 0, como string::compare de las dos letras
+   */
+  int ComparaLetra(const Tramo &t, const string &cad, size_t desde) const;
+
+  /**
+   * @brief Busca el hijo de un nodo por el que seguiria una cadena
+   * @param padre : nodo cuyos hijos se recorren
+   * @param cad : cadena buscada
+   * @param desde : posicion de cad que corresponde a los hijos de padre
+   * @param fin : posicion donde acaba el prefijo de cad (ver FinPrefijo)
+   * @param anterior : al terminar, el ultimo hijo menor que cad, o 0 si no
+   *        hay ninguno. Es el nodo tras el que habria que insertar
+   * @return El hijo que comparte la primera letra con cad (o, a profundidad
+   *         len_prefijo, la hoja igual a cad), o 0 si no hay ninguno
+   */
+  Arbol :: Nodo Hijo(Arbol :: Nodo padre, const string &cad, size_t desde, size_t fin, Arbol :: Nodo &anterior) const;
+
+  /**
+   * @brief Cuelga una rama de un nodo, tras un hijo dado
+   * @param padre : nodo del que cuelga la rama
+   * @param anterior : hijo tras el que se pone, o 0 para ponerla la primera
+   * @param rama : rama a colgar; queda vacia
+   */
+  void Cuelga(Arbol :: Nodo padre, Arbol :: Nodo anterior, Arbol &rama);
+
+  /**
+   * @brief Devuelve el hijo anterior a uno dado
+   * @param n : nodo hijo
+   * @return Su hermano izquierda, o 0 si es el hijo mas a la izquierda
+   */
+  Arbol :: Nodo HermanoIzquierda(Arbol :: Nodo n) const;
+
+public:
+  /**
+   * @brief Constructor por parametros. Inicia len_prefijo al valor lpre
+   */
+  RefranesRadix(int lpre = 3);
+
+  /**
+   * @brief devuelve el prefijo de refranes
+   * @return el prefijo
+   */
+  int getLen_prefijo () const { return len_prefijo; }
+
+  /**
+   * @brief devuelve el numero de refranes alamacenados
+   * @return el numero de refranes
+   */
+  int size () const { return n_ref; }
+
+  /**
+   * @brief Inserta un refran en el conjunto
+   * @param refran : refran a insertar
+   * @note Igual que Refranes::Insertar. Si una arista comparte solo parte de
+   *       sus letras con el refran se parte en dos, sin copiar letras en el
+   *       almacen
+   */
+  void Insertar(const string &refran);
+
+  /**
+   * @brief Borra un refrán en el conjunto
+   * @param refran : refran a borrar
+   * @note Si el padre de la hoja se queda con un solo hijo se une a el. La
+   *       etiqueta unida es el trozo del almacen que ocupan las dos si estan
+   *       seguidas; si no, se añade al almacen. Cuando la mitad del almacen
+   *       son letras que ya no usa ninguna etiqueta se compacta (ver
+   *       Caracteres_Almacen), con un coste amortizado O(1) por letra borrada
+   */
+  void BorrarRefran(const string &refran);
+
+  class iterator;
+
+  /**
+   * @brief Devuelve si un refran esta en el conjunto. Si esta devuelve un iterador a el
+   * @param refran : refran a buscar, completo
+   * @return una pareja que contiene si el refran esta y en caso afirmativo un iterador a el
+   */
+  pair<bool, iterator> Esta(const string &refran);
+
+  /**
+   * @brief Elimina todos los refranes
+   */
+  void clear();
+
+  /**
+   * @brief Lectura/Escritura de un conjunto de refranes
+   */
+  friend istream & operator>>(istream &is, RefranesRadix &R);
+  friend ostream & operator<<(ostream &os, RefranesRadix &R);
+
+  /**
+   * @brief Cuenta el numero total de los caracteres en todos los refranes
+   * @return Devuelve el numero total de caracteres en todos los refranes
+   */
+  int Caracteres_Refranes() const;
+
+  /**
+   * @brief Cuenta el numero de caracteres usados por las etiquetas del arbol
+   * @return La suma de las longitudes de las etiquetas, comparable con
+   *         Refranes::Caracteres_Almacenados
+   * @note El almacen puede ser mayor (ver Caracteres_Almacen)
+   */
+  int Caracteres_Almacenados() const;
+
+  /**
+   * @brief Cuenta los caracteres usados si las etiquetas que acaban igual
+   *        comparten el final
+   * @return Los caracteres de un AlmacenColas con las etiquetas del arbol,
+   *         comparable con Refranes::Caracteres_Colas
+   */
+  int Caracteres_Colas() const;
+
+  /**
+   * @brief Memoria ocupada por el conjunto, por categorias
+   * @return El desglose del arbol (ver ArbolGeneral::MemoryUsage), con el
+   *         almacen de caracteres como heap, comparable con Refranes::MemoryUsage
+   */
+  UsoMemoria MemoryUsage() const;
+
+  /**
+   * @brief Tamaño del almacen de caracteres
+   * @return El numero de caracteres reservados en el almacen, incluidos los
+   *         que ya no usa ninguna etiqueta tras borrar refranes, que nunca son
+   *         mas de la mitad
+   */
+  int Caracteres_Almacen() const { return almacen.size(); }
+
+  /**
+   * @brief Numero de nodos necesarios para la configuración
+   * @return El numero de nodos del arbol, raiz incluida
+   */
+  int Numero_Nodos() const;
+
+
+
+/************************ ITERADORES ************************/
+
+  	/**
+  	 * @page T.D.A. iterator
+	 *
+	 * @section esRefranesRadixIterator Conjunto Especificacion
+	 * Una instancia \e a del tipo de dato abstracto iterator es un
+	 * puntero para poder movernos a traves de los refranes, en orden alfabetico
+  	 */
+	class iterator {
+  	private:
+
+	    Arbol :: iter_preorden it;
+	    const string *almacen; // Almacen de las etiquetas
+	    string cad;
+	    string prefijo;        // Etiquetas de los antecesores del nodo actual
+	    vector<size_t> marca;  // Longitud de prefijo en cada nivel
+
+	    void Avanzar();
+	    void Situar();
+
+  	public:
+	    iterator() : almacen(0), marca(1, 0) { }
+	    const string & operator *();
+	    bool operator==(const iterator &i)const;
+	    bool operator!=(const iterator &i)const;
+	    iterator &operator ++();
+
+	    friend class RefranesRadix;
+  	};
+
+
+/*************** BEGIN y END *************/
+
+	/**
+	 * @brief Se posiciona en el primer refran
+	 * @return Un iterador al primer refran
+	 */
+	iterator begin();
+	/**
+	 * @brief Se posiciona al final, en un objeto no valido
+	 * @return Un iterador a una posicion siguiente al ultimo refran
+	 */
+	iterator end();
+};
+#endif
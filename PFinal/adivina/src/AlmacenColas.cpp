@@ -0,0 +1,59 @@
+#include "AlmacenColas.h"
+#include <algorithm>
+
+/**
+ * @file AlmacenColas.cpp
+ * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+ * @date 24/01/2017
+ * @brief Fichero implementacion del TDA AlmacenColas
+ */
+
+
+
+//-------------------------------------------------//
+//--------------FUNCIONES PUBLICAS-----------------//
+//-------------------------------------------------//
+
+void AlmacenColas :: Construye ( const vector<string> &cadenas ) {
+
+    clear();
+
+    int n = cadenas.size();
+    inicio.resize(n);
+    longitud.resize(n);
+
+    // Leidas al reves, las cadenas que acaban en c quedan justo detras de c
+    vector<int> orden(n);
+    for ( int k = 0 ; k < n ; k++ )
+        orden[k] = k;
+
+    sort(orden.begin(), orden.end(), [&cadenas] ( int a, int b ) {
+        return lexicographical_compare(cadenas[a].rbegin(), cadenas[a].rend(),
+                                       cadenas[b].rbegin(), cadenas[b].rend());
+    });
+
+    // De la ultima a la primera: si una cadena es cola de alguna otra lo es
+    // de la siguiente en el orden, que ya esta colocada
+    for ( int i = n-1 ; i >= 0 ; i-- ) {
+        const string &c = cadenas[orden[i]];
+        longitud[orden[i]] = c.size();
+
+        if ( i+1 < n ) {
+            const string &sig = cadenas[orden[i+1]];
+            if ( sig.size() >= c.size() && sig.compare(sig.size() - c.size(), c.size(), c) == 0 ) {
+                inicio[orden[i]] = inicio[orden[i+1]] + sig.size() - c.size();
+                continue;
+            }
+        }
+
+        inicio[orden[i]] = almacen.size();
+        almacen += c;
+    }
+}
+
+
+void AlmacenColas :: clear () {
+    almacen.clear();
+    inicio.clear();
+    longitud.clear();
+}
@@ -0,0 +1,185 @@
+#include "ArbolMapeado.h"
+#include "AlmacenColas.h"
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @file ArbolMapeado.cpp
+ * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+ * @date 24/01/2017
+ * @brief Fichero implementacion del TDA ArbolMapeado
+ */
+
+
+static const char MAGIA[4] = { 'A', 'G', 'B', '1' };
+
+
+
+//-------------------------------------------------//
+//--------------FUNCIONES PRIVADAS-----------------//
+//-------------------------------------------------//
+
+bool ArbolMapeado :: Valida ( const NodoBinario *tabla, int n, uint32_t tam_cadenas ) {
+
+    for ( int i = 0 ; i < n ; i++ )
+        if ( (uint64_t)tabla[i].inicio + tabla[i].longitud > tam_cadenas )
+            return false;
+
+    if ( n == 0 )
+        return true;
+
+    if ( tabla[0].padre != -1 || tabla[0].nivel != -1 || tabla[0].fin != (uint32_t)n )
+        return false;
+
+    // abiertos: el camino de la raiz al ultimo nodo visto. En preorden el padre
+    // de i es el ultimo antecesor abierto cuyo subarbol aun no se ha cerrado
+    vector<int> abiertos(1, 0);
+
+    for ( int i = 1 ; i < n ; i++ ) {
+        while ( !abiertos.empty() && tabla[abiertos.back()].fin <= (uint32_t)i )
+            abiertos.pop_back();
+
+        if ( abiertos.empty() )
+            return false;
+
+        int p = abiertos.back();
+        if ( tabla[i].padre != p || tabla[i].nivel != tabla[p].nivel + 1
+             || tabla[i].fin <= (uint32_t)i || tabla[i].fin > tabla[p].fin )
+            return false;
+
+        abiertos.push_back(i);
+    }
+
+    return true;
+}
+
+
+
+//-------------------------------------------------//
+//--------------FUNCIONES PUBLICAS-----------------//
+//-------------------------------------------------//
+
+ArbolMapeado :: ArbolMapeado () {
+    datos = 0;
+    tam = 0;
+    tabla = 0;
+    cadenas = 0;
+    n = 0;
+}
+
+
+ArbolMapeado :: ~ArbolMapeado () {
+    Cerrar();
+}
+
+
+bool ArbolMapeado :: Abrir ( const string &fichero ) {
+
+    Cerrar();
+
+    int fd = open(fichero.c_str(), O_RDONLY);
+    if ( fd < 0 )
+        return false;
+
+    struct stat st;
+    if ( fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(CabeceraBinaria) ) {
+        close(fd);
+        return false;
+    }
+
+    void *p = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // la proyeccion sigue siendo valida sin el descriptor
+
+    if ( p == MAP_FAILED )
+        return false;
+
+    const CabeceraBinaria *cab = static_cast<const CabeceraBinaria*>(p);
+    size_t esperado = sizeof(CabeceraBinaria)
+                    + (size_t)cab->nodos * sizeof(NodoBinario)
+                    + cab->tam_cadenas;
+
+    if ( memcmp(cab->magia, MAGIA, 4) != 0 || cab->version != VERSION
+         || esperado != (size_t)st.st_size || cab->nodos > (uint32_t)INT_MAX
+         || !Valida(reinterpret_cast<const NodoBinario*>(cab + 1), cab->nodos, cab->tam_cadenas) ) {
+        munmap(p, st.st_size);
+        return false;
+    }
+
+    datos = p;
+    tam = st.st_size;
+    n = cab->nodos;
+    tabla = reinterpret_cast<const NodoBinario*>(cab + 1);
+    cadenas = reinterpret_cast<const char*>(tabla + n);
+
+    return true;
+}
+
+
+void ArbolMapeado :: Cerrar () {
+
+    if ( datos != 0 )
+        munmap(datos, tam);
+
+    datos = 0;
+    tam = 0;
+    tabla = 0;
+    cadenas = 0;
+    n = 0;
+}
+
+
+bool ArbolMapeado :: EsBinario ( const string &fichero ) {
+
+    ifstream f ( fichero.c_str(), ios::binary );
+    char magia[4];
+
+    return f.read(magia, 4) && memcmp(magia, MAGIA, 4) == 0;
+}
+
+
+bool ArbolMapeado :: Escribir ( ostream &os, const ArbolPlano<string> &plano, bool compartir_colas ) {
+
+    CabeceraBinaria cab;
+    memcpy(cab.magia, MAGIA, 4);
+    cab.version = VERSION;
+    cab.nodos = plano.Size();
+    cab.tam_cadenas = 0;
+
+    vector<NodoBinario> tabla(plano.Size());
+    AlmacenColas colas;
+
+    if ( compartir_colas ) {
+        vector<string> etiquetas(plano.Size());
+        for ( int i = 0 ; i < plano.Size() ; i++ )
+            etiquetas[i] = plano.Etiqueta(i);
+        colas.Construye(etiquetas);
+        cab.tam_cadenas = colas.Caracteres();
+    }
+
+    for ( int i = 0 ; i < plano.Size() ; i++ ) {
+        tabla[i].inicio = compartir_colas ? colas.Inicio(i) : cab.tam_cadenas;
+        tabla[i].longitud = plano.Etiqueta(i).size();
+        tabla[i].fin = plano.FinSubarbol(i);
+        tabla[i].padre = plano.Padre(i);
+        tabla[i].nivel = plano.Nivel(i);
+        if ( !compartir_colas )
+            cab.tam_cadenas += tabla[i].longitud;
+    }
+
+    os.write(reinterpret_cast<const char*>(&cab), sizeof(cab));
+    if ( !tabla.empty() )
+        os.write(reinterpret_cast<const char*>(&tabla[0]), tabla.size() * sizeof(NodoBinario));
+
+    if ( compartir_colas )
+        os.write(colas.Almacen().data(), colas.Almacen().size());
+    else
+        for ( int i = 0 ; i < plano.Size() ; i++ )
+            os.write(plano.Etiqueta(i).data(), plano.Etiqueta(i).size());
+
+    return (bool)os;
+}
@@ -0,0 +1,181 @@
+#include "IndiceSufijos.h"
+#include <algorithm>
+
+/**
+ * @file IndiceSufijos.cpp
+ * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+ * @date 24/01/2017
+ * @brief Fichero implementacion del TDA IndiceSufijos
+ */
+
+
+
+//-------------------------------------------------//
+//--------------FUNCIONES PRIVADAS-----------------//
+//-------------------------------------------------//
+
+int IndiceSufijos :: Texto ( int pos ) const {
+    return upper_bound(inicio.begin(), inicio.end(), pos) - inicio.begin() - 1;
+}
+
+
+int IndiceSufijos :: Siguiente ( int l, int a, int b, int valor, int desde ) const {
+
+    if ( a >= b )
+        return -1;
+    if ( l == (int)niveles.size() )
+        return valor;
+
+    const Nivel &nv = niveles[l];
+    int ua = nv.Rango(a), ub = nv.Rango(b);
+    int a0 = a - ua, b0 = b - ub;                 // los de bit 0, en el nivel l+1
+    int a1 = nv.ceros + ua, b1 = nv.ceros + ub;   // los de bit 1
+
+    if ( desde == -1 ) // el menor de todos: por los ceros si hay alguno
+        return a0 < b0 ? Siguiente(l + 1, a0, b0, valor << 1, -1)
+                       : Siguiente(l + 1, a1, b1, (valor << 1) | 1, -1);
+
+    if ( (desde >> (niveles.size() - 1 - l)) & 1 )
+        return Siguiente(l + 1, a1, b1, (valor << 1) | 1, desde);
+
+    // Con el bit a 0 se sigue a desde; si no hay nada, cualquiera con el bit a 1
+    int k = Siguiente(l + 1, a0, b0, valor << 1, desde);
+    return k != -1 ? k : Siguiente(l + 1, a1, b1, (valor << 1) | 1, -1);
+}
+
+
+
+//-------------------------------------------------//
+//--------------FUNCIONES PUBLICAS-----------------//
+//-------------------------------------------------//
+
+void IndiceSufijos :: Construye ( const vector<string> &textos ) {
+
+    clear();
+
+    for ( size_t k = 0 ; k < textos.size() ; k++ ) {
+        inicio.push_back(corpus.size());
+        corpus += textos[k];
+        corpus += '\n';
+    }
+
+    int n = corpus.size();
+    sufijos.resize(n);
+    vector<int> rango(n), aux(n);
+
+    for ( int i = 0 ; i < n ; i++ ) {
+        sufijos[i] = i;
+        rango[i] = (unsigned char)corpus[i];
+    }
+
+    // Tras cada vuelta los sufijos estan ordenados por sus 2*salto primeras
+    // letras, usando el rango ya calculado de las dos mitades
+    for ( int salto = 1 ; n > 0 ; salto *= 2 ) {
+        auto menor = [&rango, salto, n] ( int a, int b ) {
+            if ( rango[a] != rango[b] )
+                return rango[a] < rango[b];
+            int ra = a + salto < n ? rango[a + salto] : -1;
+            int rb = b + salto < n ? rango[b + salto] : -1;
+            return ra < rb;
+        };
+
+        sort(sufijos.begin(), sufijos.end(), menor);
+
+        aux[sufijos[0]] = 0;
+        for ( int i = 1 ; i < n ; i++ )
+            aux[sufijos[i]] = aux[sufijos[i-1]] + ( menor(sufijos[i-1], sufijos[i]) ? 1 : 0 );
+        rango.swap(aux);
+
+        if ( rango[sufijos[n-1]] == n-1 ) // todos distintos
+            break;
+    }
+
+    if ( n == 0 )
+        return;
+
+    // Matriz de ondiculas del texto de cada sufijo, un nivel por bit
+    vector<int> texto(n);
+    for ( int i = 0 ; i < n ; i++ )
+        texto[i] = Texto(sufijos[i]);
+
+    int nbits = 1;
+    while ( ((int)inicio.size() - 1) >> nbits )
+        nbits++;
+    niveles.resize(nbits);
+
+    for ( int l = 0 ; l < nbits ; l++ ) {
+        Nivel &nv = niveles[l];
+        int bit = nbits - 1 - l;
+        nv.bits.assign(n / 64 + 1, 0);
+        nv.unos.assign(n / 64 + 1, 0);
+
+        for ( int i = 0 ; i < n ; i++ )
+            if ( (texto[i] >> bit) & 1 )
+                nv.bits[i >> 6] |= uint64_t(1) << (i & 63);
+        for ( size_t w = 1 ; w < nv.bits.size() ; w++ )
+            nv.unos[w] = nv.unos[w-1] + __builtin_popcountll(nv.bits[w-1]);
+
+        // Los de bit 0 delante, sin cambiar su orden
+        stable_partition(texto.begin(), texto.end(), [bit] ( int t ) { return !((t >> bit) & 1); });
+        nv.ceros = n - nv.Rango(n);
+    }
+}
+
+
+void IndiceSufijos :: clear () {
+    corpus.clear();
+    sufijos.clear();
+    inicio.clear();
+    niveles.clear();
+}
+
+
+pair<int, int> IndiceSufijos :: Intervalo ( const string &patron ) const {
+
+    int m = patron.size();
+
+    // Primer sufijo que no es menor que el patron
+    int a = 0, b = sufijos.size();
+    while ( a < b ) {
+        int c = (a + b) / 2;
+        if ( corpus.compare(sufijos[c], m, patron) < 0 )
+            a = c + 1;
+        else
+            b = c;
+    }
+
+    // Primer sufijo cuyas m primeras letras son mayores que el patron
+    int primero = a;
+    b = sufijos.size();
+    while ( a < b ) {
+        int c = (a + b) / 2;
+        if ( corpus.compare(sufijos[c], m, patron) <= 0 )
+            a = c + 1;
+        else
+            b = c;
+    }
+
+    return pair<int, int>(primero, a);
+}
+
+
+int IndiceSufijos :: Cuenta ( const string &patron ) const {
+
+    if ( patron.empty() || patron.find('\n') != string :: npos )
+        return 0;
+
+    pair<int, int> r = Intervalo(patron);
+    return r.second - r.first;
+}
+
+
+int IndiceSufijos :: Primero ( const string &patron, int desde ) const {
+
+    if ( patron.find('\n') != string :: npos || desde >= size() )
+        return -1;
+    if ( patron.empty() )
+        return desde;
+
+    pair<int, int> r = Intervalo(patron);
+    return Siguiente(0, r.first, r.second, 0, max(desde, 0));
+}
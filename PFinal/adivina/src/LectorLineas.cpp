@@ -0,0 +1,88 @@
+#include "LectorLineas.h"
+#include "Utf8.h"
+#include <cstring>
+
+/**
+ * @file LectorLineas.cpp
+ * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+ * @date 24/01/2017
+ * @brief Fichero implementacion del lector de lineas de refranes
+ */
+
+
+
+//-------------------------------------------------//
+//--------------FUNCIONES PRIVADAS-----------------//
+//-------------------------------------------------//
+
+bool LectorLineas :: Rellenar () {
+
+    streamsize n = is.rdbuf() != 0 ? is.rdbuf()->sgetn(&bloque[0], bloque.size()) : 0;
+
+    pos = 0;
+    fin = n > 0 ? n : 0;
+    leidos += fin;
+
+    return fin > 0;
+}
+
+
+
+//-------------------------------------------------//
+//--------------FUNCIONES PUBLICAS-----------------//
+//-------------------------------------------------//
+
+LectorLineas :: LectorLineas ( istream &entrada, bool minusc, bool sin_acentos ) : is(entrada), bloque(TAM_BLOQUE) {
+    pos = 0;
+    fin = 0;
+    minusculas = minusc;
+    acentos = !sin_acentos;
+    leidos = 0;
+}
+
+
+bool LectorLineas :: Siguiente () {
+
+    do {
+        linea.clear();
+        bool salto = false;
+
+        // Copiamos hasta el siguiente '\n', que puede estar en otro bloque
+        while ( !salto ) {
+            if ( pos == fin && !Rellenar() ) {
+                if ( linea.empty() ) {
+                    is.setstate(ios :: eofbit);
+                    return false;
+                }
+                break;
+            }
+
+            const char *ini = &bloque[pos];
+            const char *nl = static_cast<const char*>( memchr(ini, '\n', fin - pos) );
+            size_t n = nl != 0 ? nl - ini : fin - pos;
+
+            linea.append(ini, n);
+
+            pos += n;
+            if ( nl != 0 ) {
+                pos++;
+                salto = true;
+            }
+        }
+
+        // Fin de linea de Windows y espacios del final
+        size_t l = linea.size();
+        while ( l > 0 && (linea[l-1] == '\r' || linea[l-1] == ' ' || linea[l-1] == '\t') )
+            l--;
+        linea.resize(l);
+
+        // Sobre la linea completa, porque una letra puede quedar entre dos bloques
+        if ( minusculas )
+            Utf8 :: Minusculas(linea);
+        if ( !acentos )
+            Utf8 :: QuitaAcentos(linea);
+
+    } while ( linea.empty() );
+
+    return true;
+}
@@ -0,0 +1,132 @@
+#include "Utf8.h"
+
+/**
+ * @file Utf8.cpp
+ * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+ * @date 24/01/2017
+ * @brief Fichero implementacion de las funciones para recorrer por letras
+ *        los refranes escritos en UTF-8
+ */
+
+
+
+//-------------------------------------------------//
+//--------------FUNCIONES PRIVADAS-----------------//
+//-------------------------------------------------//
+
+/**
+ * @brief Letra sin acento de cada caracter de U+00C0 a U+00FF, indexada por
+ *        el segundo byte de su codificacion (0xC3 0x80 a 0xC3 0xBF) menos 0x80.
+ *        Un 0 indica que la letra se deja como esta (Æ, Ñ, ×, ß, ...)
+ */
+static const char SIN_ACENTO[64 + 1] =
+    "AAAAAA\0CEEEEIIII\0\0OOOOO\0\0UUUUY\0\0"
+    "aaaaaa\0ceeeeiiii\0\0ooooo\0\0uuuuy\0y";
+
+
+/**
+ * @brief Indica si hay una marca diacritica (U+0300 a U+036F) en una posicion
+ */
+static bool EsDiacritico ( const string &cad, size_t pos ) {
+    if ( pos + 1 >= cad.size() )
+        return false;
+
+    unsigned char a = cad[pos], b = cad[pos+1];
+    return (a == 0xCC && b >= 0x80 && b <= 0xBF) || (a == 0xCD && b >= 0x80 && b <= 0xAF);
+}
+
+
+
+//-------------------------------------------------//
+//--------------FUNCIONES PUBLICAS-----------------//
+//-------------------------------------------------//
+
+size_t Utf8 :: LongitudLetra ( const string &cad, size_t pos ) {
+
+    unsigned char c = cad[pos];
+    size_t l = 1;
+
+    if ( c >= 0xC2 && c <= 0xDF )
+        l = 2;
+    else if ( c >= 0xE0 && c <= 0xEF )
+        l = 3;
+    else if ( c >= 0xF0 && c <= 0xF4 )
+        l = 4;
+
+    // Un punto de codigo cortado o mal formado cuenta como un solo byte
+    if ( pos + l > cad.size() )
+        l = 1;
+    for ( size_t i = 1 ; i < l ; i++ )
+        if ( ((unsigned char)cad[pos+i] & 0xC0) != 0x80 )
+            l = 1;
+
+    while ( EsDiacritico(cad, pos + l) )
+        l += 2;
+
+    return l;
+}
+
+
+int Utf8 :: Letras ( const string &cad, int maximo ) {
+
+    int n = 0;
+    for ( size_t pos = 0 ; pos < cad.size() && n < maximo ; n++ )
+        pos += LongitudLetra(cad, pos);
+
+    return n;
+}
+
+
+void Utf8 :: Minusculas ( string &cad ) {
+
+    size_t n = cad.size();
+
+    for ( size_t i = 0 ; i < n ; i++ ) {
+        unsigned char c = cad[i];
+
+        if ( c >= 'A' && c <= 'Z' )
+            cad[i] = c + ('a' - 'A');
+        else if ( c == 0xC3 && i + 1 < n ) {
+            unsigned char b = cad[i+1];
+            if ( b >= 0x80 && b <= 0x9E && b != 0x97 ) // U+00D7 es el signo ×
+                cad[i+1] = b + 0x20;
+            i++;
+        }
+    }
+}
+
+
+void Utf8 :: QuitaAcentos ( string &cad ) {
+
+    size_t n = cad.size(), j = 0;
+
+    for ( size_t i = 0 ; i < n ; ) {
+        unsigned char c = cad[i];
+
+        if ( c == 0xC3 && i + 1 < n && (unsigned char)cad[i+1] >= 0x80
+             && (unsigned char)cad[i+1] <= 0xBF ) {
+            char base = SIN_ACENTO[(unsigned char)cad[i+1] - 0x80];
+            if ( base != 0 )
+                cad[j++] = base;
+            else {
+                cad[j++] = cad[i];
+                cad[j++] = cad[i+1];
+            }
+            i += 2;
+        }
+        else if ( EsDiacritico(cad, i) ) {
+            // Una 'n' seguida de la tilde combinable (U+0303) es una ñ
+            bool tilde = (unsigned char)cad[i] == 0xCC && (unsigned char)cad[i+1] == 0x83;
+            if ( tilde && j > 0 && (cad[j-1] == 'n' || cad[j-1] == 'N') ) {
+                char segundo = cad[j-1] == 'n' ? '\xB1' : '\x91';
+                cad[j-1] = '\xC3';
+                cad[j++] = segundo;
+            }
+            i += 2;
+        }
+        else
+            cad[j++] = cad[i++];
+    }
+
+    cad.resize(j);
+}
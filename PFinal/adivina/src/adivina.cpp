@@ -3,8 +3,11 @@
 #include <cstdlib>
 #include <string>
 #include <utility>
+#include <ctime>
+#include <random>
 #include <ctype.h>
 #include "refranes.h"
+#include "refranes_mapeados.h"
 
 using namespace std;
 
@@ -27,23 +30,24 @@ void ImprimeRefran ( const string& Refran ) ;
 /**
  * @brief Metodo para seleccionar un refran aleatoriamente
  * @param refs : objeto refranes del que se selecciona uno
+ * @param gen : generador de numeros aleatorios del juego
  * @return Devolvemos el refran seleccionado
  */ 
-string SeleccionRefran ( Refranes refs ) {
+string SeleccionRefran ( const Refranes &refs, mt19937 &gen ) {
 
-  //Obtengo el numero de refranes leido
-  int totalRefranes = refs.size();
-  Refranes :: iterator it;
-  it = refs.begin();
+  // Vamos directamente a uno al azar, sin pasar por los anteriores
+  return *refs.Aleatorio(gen);
+}
 
-  srand (time(NULL));
-  int nReframElegido = rand() % totalRefranes; // selecciona uno aleatorio
 
-  // Nos posicionamos en el elegido
-  for (int i  = 0; i < nReframElegido; i++)
-    ++it;
-  
-  return (*it);
+/**
+ * @brief Metodo para seleccionar un refran aleatoriamente de un fichero binario
+ * @param refs : refranes proyectados del fichero
+ * @param gen : generador de numeros aleatorios del juego
+ * @return Devolvemos el refran seleccionado
+ */ 
+string SeleccionRefran ( const RefranesMapeados &refs, mt19937 &gen ) {
+  return refs.Aleatorio(gen);
 }
 
 
@@ -144,9 +148,10 @@ pair<int,string> Destaparletras ( const string& original, const string& refranJu
  * @brief Este metodo oculta el porcentaje de letras indicado en el refran dado
  * @param original : el refran a tratar
  * @param porcentaje : el porcentaje de letras que vamos a ocultar de original
+ * @param gen : generador de numeros aleatorios del juego
  * @return Devuelve el nuevo refran, ya con un numero de letras ocultadas
  */
-string Ocultarletras ( const string& original, const int& porcentaje ) {
+string Ocultarletras ( const string& original, const int& porcentaje, mt19937 &gen ) {
 
 	string result = original;
 	int tamano = 0;
@@ -165,8 +170,7 @@ string Ocultarletras ( const string& original, const int& porcentaje ) {
 	    bool encontrado = false;   
 	    char letraAocultar = '_';
 
-	    srand (time(NULL));
-	    int pos = rand() % (tamano + 1);
+	    int pos = uniform_int_distribution<int>(0, tamano)(gen);
 	    letraAocultar = result[pos];
     
 	    if ( letraAocultar == '_' || letraAocultar == ' ' ) {
@@ -234,15 +238,36 @@ int main ( int argc, char * argv[] ) {
     	porcentaje = atoi(argv[2]);
 
   	Refranes refs(3);
+  	RefranesMapeados mapeados;
   
 	int rondas = 1; // Inicializamos las rondas
 	// Estimamos el numero de intentos en funcion del porcentaje tendremos mas o menos intentos
 	int IntentosTotales = CalculaIntentos(porcentaje); 
 	int cuentaIntentos = 0; // Contador para saber cuantos intentos lleva el jugador
 	int cuentaAyuda = 0; 	// Contador para la ayuda
+	mt19937 gen(time(NULL)); // Se siembra una sola vez para toda la partida
+
+	// Los ficheros binarios (ver convierte_arbol) se consultan desde la
+	// proyeccion, sin analizar texto ni construir el arbol
+	bool binario = ArbolMapeado :: EsBinario(argv[1]);
+	if ( binario ) {
+		if ( !mapeados.Abrir(argv[1]) ) {
+			cout << " El fichero binario " << argv[1] << " esta dañado o es de otra version" << endl;
+			return 1;
+		}
+	}
+	else {
+		fin >> refs;
+	}
+
+	if ( (binario ? mapeados.size() : refs.size()) == 0 ) {
+		cout << " El fichero " << argv[1] << " no tiene ningun refran" << endl;
+		return 1;
+	}
 
-	fin >> refs;
-	string Refran = SeleccionRefran(refs); // Selecciona un refran aleatorio
+	// Selecciona un refran aleatorio del conjunto que se haya cargado
+	auto Selecciona = [&] () { return binario ? SeleccionRefran(mapeados, gen) : SeleccionRefran(refs, gen); };
+	string Refran = Selecciona();
 
 
 	cout << "\n\n ************************** QUE COMIENCE EL JUEGO ***************************" 
@@ -251,7 +276,7 @@ int main ( int argc, char * argv[] ) {
 	cout << "\n Ocultando refrán... "
 	     << "\n Tienes " << IntentosTotales << " intentos para acertar..." << endl << endl;
 
-	string refranOculto = Ocultarletras ( Refran, porcentaje );
+	string refranOculto = Ocultarletras ( Refran, porcentaje, gen );
 
 	char continuar = 's';
 	char letra;
@@ -328,8 +353,8 @@ int main ( int argc, char * argv[] ) {
 	        	if ( continuar == 's' ) {
 					cuentaIntentos = 0;
 					cuentaAyuda = 0;
-					Refran = SeleccionRefran(refs);
-					refranOculto = Ocultarletras ( Refran, porcentaje );
+					Refran = Selecciona();
+					refranOculto = Ocultarletras ( Refran, porcentaje, gen );
 					rondas++;
 					cout << "\n\n ************************** QUE COMIENCE EL JUEGO ***************************" 
                			 << endl << "\n\t\t\t   ¡¡¡ ADIVINA REFRAN !!!"
@@ -357,8 +382,8 @@ int main ( int argc, char * argv[] ) {
 	        	if ( continuar == 's' ) {
 	          		cuentaIntentos = 0; 
 	          		cuentaAyuda = 0;
-	          		Refran = SeleccionRefran(refs);
-	          		refranOculto = Ocultarletras ( Refran, porcentaje );
+	          		Refran = Selecciona();
+	          		refranOculto = Ocultarletras ( Refran, porcentaje, gen );
 	          		rondas++;
 	          		cout << "\n\n ************************** QUE COMIENCE EL JUEGO ***************************" 
                			 << endl << "\n\t\t\t   ¡¡¡ ADIVINA REFRAN !!!"
@@ -397,8 +422,8 @@ int main ( int argc, char * argv[] ) {
         	if ( continuar == 's' ) {
           		cuentaIntentos = 0; 
           		cuentaAyuda = 0;
-          		Refran = SeleccionRefran(refs);
-          		refranOculto = Ocultarletras ( Refran, porcentaje );
+          		Refran = Selecciona();
+          		refranOculto = Ocultarletras ( Refran, porcentaje, gen );
           		rondas++;
           		cout << "\n\n ************************** QUE COMIENCE EL JUEGO ***************************" 
                		 << endl << "\n\t\t\t   ¡¡¡ ADIVINA REFRAN !!!"
@@ -3,6 +3,8 @@
 #include <cstdlib>
 #include <string>
 #include <utility>
+#include <ctime>
+#include <random>
 #include <ctype.h>
 #include "refranes_hash.h"
 
@@ -27,23 +29,13 @@ void ImprimeRefran ( const string& Refran ) ;
 /**
  * @brief Metodo para seleccionar un refran aleatoriamente
  * @param refs : objeto refranes del que se selecciona uno
+ * @param gen : generador de numeros aleatorios del juego
  * @return Devolvemos el refran seleccionado
  */ 
-string SeleccionRefran ( Refranes refs ) {
+string SeleccionRefran ( const Refranes &refs, mt19937 &gen ) {
 
-  //Obtengo el numero de refranes leido
-  int totalRefranes = refs.size();
-  Refranes :: iterator it;
-  it = refs.begin();
-
-  srand (time(NULL));
-  int nReframElegido = rand() % totalRefranes; // selecciona uno aleatorio
-
-  // Nos posicionamos en el elegido
-  for (int i  = 0; i < nReframElegido; i++)
-    ++it;
-  
-  return (*it);
+  // Se sortea entre todos a la vez, sin recorrer la tabla
+  return refs.Aleatorio(gen);
 }
 
 
@@ -144,9 +136,10 @@ pair<int,string> Destaparletras ( const string& original, const string& refranJu
  * @brief Este metodo oculta el porcentaje de letras indicado en el refran dado
  * @param original : el refran a tratar
  * @param porcentaje : el porcentaje de letras que vamos a ocultar de original
+ * @param gen : generador de numeros aleatorios del juego
  * @return Devuelve el nuevo refran, ya con un numero de letras ocultadas
  */
-string Ocultarletras ( const string& original, const int& porcentaje ) {
+string Ocultarletras ( const string& original, const int& porcentaje, mt19937 &gen ) {
 
   string result = original;
   int tamano = 0;
@@ -165,8 +158,7 @@ string Ocultarletras ( const string& original, const int& porcentaje ) {
     bool encontrado = false;   
     char letraAocultar = '_';
 
-    srand (time(NULL));
-    int pos = rand() % (tamano + 1);
+    int pos = uniform_int_distribution<int>(0, tamano)(gen);
     letraAocultar = result[pos];
     
     if ( letraAocultar == '_' || letraAocultar == ' ' ) {
@@ -240,9 +232,10 @@ int main ( int argc, char * argv[] ) {
   int IntentosTotales = CalculaIntentos(porcentaje); 
   int cuentaIntentos = 0; // Contador para saber cuantos intentos lleva el jugador
   int cuentaAyuda = 0;  // Contador para la ayuda
+  mt19937 gen(time(NULL)); // Se siembra una sola vez para toda la partida
 
   fin >> refs;
-  string Refran = SeleccionRefran(refs); // Selecciona un refran aleatorio
+  string Refran = SeleccionRefran(refs, gen); // Selecciona un refran aleatorio
 
 
   cout << "\n ** ESTAMOS EN ADIVINA_HASH ** " << endl << endl;
@@ -253,7 +246,7 @@ int main ( int argc, char * argv[] ) {
   cout << "\n Ocultando refrán... "
        << "\n Tienes " << IntentosTotales << " intentos para acertar..." << endl << endl;
 
-  string refranOculto = Ocultarletras ( Refran, porcentaje );
+  string refranOculto = Ocultarletras ( Refran, porcentaje, gen );
 
   char continuar = 's';
   char letra;
@@ -331,8 +324,8 @@ int main ( int argc, char * argv[] ) {
         if ( continuar == 's' ) {
           cuentaIntentos = 0;
           cuentaAyuda = 0;
-          Refran = SeleccionRefran(refs);
-          refranOculto = Ocultarletras ( Refran, porcentaje );
+          Refran = SeleccionRefran(refs, gen);
+          refranOculto = Ocultarletras ( Refran, porcentaje, gen );
           rondas++;
           cout << "\n\n ************************** QUE COMIENCE EL JUEGO ***************************" 
                << endl << "\n\t\t\t   ¡¡¡ ADIVINA REFRAN !!!"
@@ -360,8 +353,8 @@ int main ( int argc, char * argv[] ) {
         if ( continuar == 's' ) {
           cuentaIntentos = 0; 
           cuentaAyuda = 0;
-          Refran = SeleccionRefran(refs);
-          refranOculto = Ocultarletras ( Refran, porcentaje );
+          Refran = SeleccionRefran(refs, gen);
+          refranOculto = Ocultarletras ( Refran, porcentaje, gen );
           rondas++;
           cout << "\n\n ************************** QUE COMIENCE EL JUEGO ***************************" 
                << endl << "\n\t\t\t   ¡¡¡ ADIVINA REFRAN !!!"
@@ -401,8 +394,8 @@ int main ( int argc, char * argv[] ) {
         if ( continuar == 's' ) {
           cuentaIntentos = 0; 
           cuentaAyuda = 0;
-          Refran = SeleccionRefran(refs);
-          refranOculto = Ocultarletras ( Refran, porcentaje );
+          Refran = SeleccionRefran(refs, gen);
+          refranOculto = Ocultarletras ( Refran, porcentaje, gen );
           rondas++;
           cout << "\n\n ************************** QUE COMIENCE EL JUEGO ***************************" 
                << endl << "\n\t\t\t   ¡¡¡ ADIVINA REFRAN !!!"
@@ -0,0 +1,919 @@
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <glob.h>
+#include "refranes.h"
+#include "refranes_radix.h"
+#include "refranes_mapeados.h"
+#include "refranes_compartidos.h"
+#include "LectorLineas.h"
+#include "Utf8.h"
+
+using namespace std;
+
+
+/**
+ * @file comprueba_refranes.cpp
+ * @author Gregorio Vidoy Fajardo y Jesus Ruiz Castellano
+ * @date 19 de Enero de 2017, 18:40
+ * @brief Fichero con las pruebas automaticas del TDA Refranes. Cada prueba
+ *        compara el conjunto con un set<string> que hace de referencia
+ */
+
+
+int fallos = 0; // Numero de comprobaciones fallidas
+
+
+/**
+ * @brief Anota un fallo si no se cumple la condicion
+ * @param cond : condicion a comprobar
+ * @param msg : descripcion de la comprobacion
+ */
+void Comprobar ( bool cond, const string &msg ) {
+
+  if ( !cond ) {
+    cout << " FALLO : " << msg << endl;
+    fallos++;
+  }
+}
+
+
+/**
+ * @brief Letras con las que se forman los refranes de prueba: pocas, para que
+ *        se repitan los prefijos, y con caracteres de varios bytes (ñ, á y una
+ *        e seguida de un acento combinante, que es una sola letra)
+ */
+const char *LETRAS[] = { "a", "b", "c", " ", "\xc3\xb1", "\xc3\xa1", "e\xcc\x81" };
+const int NUM_LETRAS = sizeof(LETRAS) / sizeof(LETRAS[0]);
+
+
+/**
+ * @brief Construye un refran aleatorio
+ * @param maximo : numero maximo de letras
+ * @return Un refran de 0 a maximo letras, sin espacios al final
+ */
+string RefranAleatorio ( int maximo ) {
+
+  string refran;
+  int n = rand() % (maximo + 1);
+
+  for ( int i = 0 ; i < n ; i++ )
+    refran += LETRAS[rand() % NUM_LETRAS];
+
+  // Las lineas se leen sin espacios al final (ver LectorLineas)
+  while ( !refran.empty() && refran[refran.size() - 1] == ' ' )
+    refran.erase(refran.size() - 1);
+
+  return refran;
+}
+
+
+/**
+ * @brief Indica si un refran tiene letras suficientes para guardarse
+ * @param refran : refran a comprobar
+ * @param lpre : longitud del prefijo del conjunto
+ */
+bool Cabe ( const string &refran, int lpre ) {
+
+  return Utf8 :: Letras(refran, lpre) >= lpre;
+}
+
+
+/**
+ * @brief Todos los refranes de un conjunto, en el orden de su recorrido
+ * @param refs : conjunto a recorrer
+ */
+vector<string> Contenido ( const Refranes &refs ) {
+
+  vector<string> v;
+
+  for ( Refranes :: const_iterator it = refs.Cbegin() ; it != refs.Cend() ; ++it )
+    v.push_back(*it);
+
+  return v;
+}
+
+
+/**
+ * @brief Comprueba todo el conjunto contra la referencia: tamaño, recorrido
+ *        en orden y RefranK
+ * @param refs : conjunto a comprobar
+ * @param ref : conjunto de referencia
+ * @param msg : descripcion del paso
+ */
+void Compara ( const Refranes &refs, const set<string> &ref, const string &msg ) {
+
+  vector<string> v = Contenido(refs);
+
+  Comprobar(refs.size() == (int)ref.size(), "size() " + msg);
+  Comprobar(v == vector<string>(ref.begin(), ref.end()), "recorrido en orden " + msg);
+
+  for ( size_t k = 0 ; k < v.size() ; k += 1 + rand() % 4 )
+    Comprobar(*refs.RefranK(k) == v[k], "RefranK " + msg);
+}
+
+
+/**
+ * @brief Inserta refranes al azar, repetidos y mas cortos que len_prefijo, y
+ *        comprueba que el conjunto coincide con la referencia, con distintos
+ *        len_prefijo y umbrales
+ */
+void TestInsertar () {
+
+  for ( int prueba = 0 ; prueba < 60 ; prueba++ ) {
+
+    int lpre = 1 + prueba % 4;
+    Refranes refs(lpre, prueba % 3 == 0 ? 2 : 0);
+    set<string> ref;
+
+    for ( int paso = 0 ; paso < 150 ; paso++ ) {
+
+      string refran = RefranAleatorio(8);
+      refs.Insertar(refran);
+      if ( Cabe(refran, lpre) )
+        ref.insert(refran);
+
+      if ( paso % 25 == 24 )
+        Compara(refs, ref, "tras insertar");
+    }
+
+    // Las copias tienen los mismos refranes
+    Refranes copia(refs);
+    Compara(copia, ref, "en la copia");
+  }
+}
+
+
+/**
+ * @brief Comprueba que Esta solo encuentra los refranes completos: ni un
+ *        principio ni una continuacion de un refran cuentan como el
+ */
+void TestEsta () {
+
+  for ( int prueba = 0 ; prueba < 60 ; prueba++ ) {
+
+    int lpre = 1 + prueba % 4;
+    Refranes refs(lpre, prueba % 3 == 0 ? 2 : 0);
+    set<string> ref;
+
+    for ( int paso = 0 ; paso < 150 ; paso++ ) {
+
+      string refran = RefranAleatorio(8);
+      if ( rand() % 2 == 0 ) {
+        refs.Insertar(refran);
+        if ( Cabe(refran, lpre) )
+          ref.insert(refran);
+      }
+
+      pair<bool, Refranes :: const_iterator> e = ((const Refranes &)refs).Esta(refran);
+      Comprobar(e.first == (ref.count(refran) > 0), "Esta de un refran");
+      if ( e.first )
+        Comprobar(*e.second == refran, "Esta apunta al refran buscado");
+
+      string corto = refran.substr(0, refran.size() / 2), largo = refran + "a";
+      Comprobar(refs.Esta(corto).first == (ref.count(corto) > 0), "Esta de un principio");
+      Comprobar(refs.Esta(largo).first == (ref.count(largo) > 0), "Esta de una continuacion");
+    }
+  }
+}
+
+
+/**
+ * @brief Inserta y borra refranes al azar, uno a uno y varios a la vez, y
+ *        comprueba tras cada paso que el conjunto coincide con la referencia
+ *        y que al borrarlos todos solo queda la raiz
+ */
+void TestBorrar () {
+
+  for ( int prueba = 0 ; prueba < 60 ; prueba++ ) {
+
+    int lpre = 1 + prueba % 4;
+    Refranes refs(lpre, prueba % 3 == 0 ? 2 : 0);
+    set<string> ref;
+
+    for ( int paso = 0 ; paso < 150 ; paso++ ) {
+
+      string refran = RefranAleatorio(8);
+
+      if ( rand() % 3 != 0 ) {
+        refs.Insertar(refran);
+        if ( Cabe(refran, lpre) )
+          ref.insert(refran);
+      }
+      else {
+        if ( !ref.empty() && rand() % 2 == 0 ) { // uno que esta
+          set<string> :: iterator it = ref.begin();
+          advance(it, rand() % ref.size());
+          refran = *it;
+        }
+        refs.BorrarRefran(refran);
+        ref.erase(refran);
+      }
+
+      Comprobar(refs.Esta(refran).first == (ref.count(refran) > 0), "Esta del refran modificado");
+      Comprobar(refs.size() == (int)ref.size(), "size() tras modificar");
+    }
+
+    Compara(refs, ref, "tras insertar y borrar");
+
+    // Borrado de varios a la vez, con alguno que no esta
+    vector<string> borrar;
+    for ( set<string> :: iterator it = ref.begin() ; it != ref.end() ; ++it )
+      if ( rand() % 2 == 0 )
+        borrar.push_back(*it);
+    borrar.push_back("zzz no esta");
+
+    int borrados = refs.BorrarRefranes(borrar);
+    Comprobar(borrados == (int)borrar.size() - 1, "BorrarRefranes devuelve los borrados");
+    for ( size_t i = 0 ; i < borrar.size() ; i++ )
+      ref.erase(borrar[i]);
+    Compara(refs, ref, "tras BorrarRefranes");
+
+    // Sin refranes no quedan ramas vacias
+    refs.BorrarRefranes(vector<string>(ref.begin(), ref.end()));
+    Compara(refs, set<string>(), "tras borrarlos todos");
+    Comprobar(refs.Numero_Nodos() == 1, "tras borrarlos todos solo queda la raiz");
+  }
+}
+
+
+/**
+ * @brief Sortea muchas veces un refran y comprueba que salen todos los de la
+ *        referencia, ninguno mas, y cada uno un numero de veces parecido
+ * @param refs : conjunto del que se sortea, con los refranes de ref
+ * @param ref : conjunto de referencia, no vacio
+ * @param gen : generador para Aleatorio
+ * @param msg : descripcion del paso
+ * @note Con 2000 sorteos por refran la desviacion de cada cuenta es de unos
+ *       45; se admite un 20%, unas 9 desviaciones
+ */
+void CompruebaSorteo ( const Refranes &refs, const set<string> &ref, mt19937 &gen, const string &msg ) {
+
+  const int VECES = 2000;
+  map<string, int> cuenta;
+
+  for ( size_t i = 0 ; i < VECES * ref.size() ; i++ )
+    cuenta[*refs.Aleatorio(gen)]++;
+
+  bool todos = cuenta.size() == ref.size(), parecidos = true;
+  for ( map<string, int> :: iterator it = cuenta.begin() ; it != cuenta.end() ; ++it ) {
+    todos = todos && ref.count(it->first) > 0;
+    parecidos = parecidos && it->second > VECES * 0.8 && it->second < VECES * 1.2;
+  }
+
+  Comprobar(todos, "Aleatorio saca todos los refranes y solo ellos " + msg);
+  Comprobar(parecidos, "Aleatorio saca cada refran con la misma probabilidad " + msg);
+}
+
+
+/**
+ * @brief Comprueba Aleatorio tras insertar y borrar, en una copia y tras
+ *        una asignacion
+ */
+void TestAleatorio () {
+
+  mt19937 gen(1);
+
+  for ( int prueba = 0 ; prueba < 8 ; prueba++ ) {
+
+    int lpre = 1 + prueba % 4;
+    Refranes refs(lpre, prueba % 2 == 0 ? 0 : 3);
+    set<string> ref;
+
+    while ( ref.size() < 40 ) {
+      string refran = RefranAleatorio(8);
+      refs.Insertar(refran);
+      if ( Cabe(refran, lpre) )
+        ref.insert(refran);
+    }
+    CompruebaSorteo(refs, ref, gen, "tras insertar");
+
+    Refranes copia(refs);
+    Refranes asignado(lpre);
+    asignado.Insertar("refran que se pierde al asignar");
+    asignado = refs;
+
+    set<string> quedan;
+    for ( set<string> :: iterator it = ref.begin() ; it != ref.end() ; ++it )
+      if ( rand() % 3 == 0 )
+        refs.BorrarRefran(*it);
+      else
+        quedan.insert(*it);
+    Compara(refs, quedan, "tras borrar");
+    CompruebaSorteo(refs, quedan, gen, "tras borrar");
+
+    CompruebaSorteo(copia, ref, gen, "en la copia");
+    CompruebaSorteo(asignado, ref, gen, "tras asignar");
+  }
+}
+
+
+/**
+ * @brief Comprueba que BuildFromSorted deja los mismos refranes y el mismo
+ *        arbol que insertarlos uno a uno, tambien con lineas desordenadas
+ */
+void TestBuildFromSorted () {
+
+  for ( int prueba = 0 ; prueba < 40 ; prueba++ ) {
+
+    int lpre = 1 + prueba % 4;
+    Refranes insertados(lpre), cargados(lpre);
+    set<string> ref;
+
+    for ( int i = 0 ; i < 200 ; i++ ) {
+      string refran = RefranAleatorio(8);
+      insertados.Insertar(refran);
+      if ( Cabe(refran, lpre) )
+        ref.insert(refran);
+    }
+
+    stringstream ss;
+    for ( set<string> :: iterator it = ref.begin() ; it != ref.end() ; ++it )
+      ss << *it << endl;
+    if ( prueba % 2 == 1 && !ref.empty() )
+      ss << *ref.begin() << endl << "a" << endl; // repetido y desordenado
+
+    cargados.Insertar("refran que se descarta");
+    cargados.BuildFromSorted(ss);
+
+    Compara(cargados, ref, "tras BuildFromSorted");
+    Comprobar(Contenido(cargados) == Contenido(insertados), "BuildFromSorted igual que Insertar");
+    Comprobar(cargados.Numero_Nodos() == insertados.Numero_Nodos(), "mismos nodos que con Insertar");
+    Comprobar(cargados.Caracteres_Refranes() == insertados.Caracteres_Refranes(), "mismos caracteres que con Insertar");
+  }
+}
+
+
+/**
+ * @brief Ordena un fichero por tramos y comprueba que la salida tiene las
+ *        lineas ordenadas y sin repetir, que no quedan temporales y que no se
+ *        toca ningun otro fichero junto a la salida
+ */
+void TestOrdenaFichero () {
+
+  const char *entrada = "comprueba_refranes.txt";
+  const string salida = "comprueba_refranes.ord";
+  const string ajeno = salida + ".0"; // nombre de los temporales de antes
+
+  {
+    ofstream f(ajeno.c_str());
+    f << "no se toca" << endl;
+  }
+
+  for ( int prueba = 0 ; prueba < 10 ; prueba++ ) {
+
+    set<string> ref;
+    {
+      ofstream f(entrada);
+      for ( int i = 0 ; i < 300 ; i++ ) {
+        string linea = RefranAleatorio(6);
+        f << linea << endl;
+        if ( !linea.empty() )
+          ref.insert(linea);
+      }
+    }
+
+    Comprobar(Refranes :: OrdenaFichero(entrada, salida, 1 + prueba * 7), "OrdenaFichero");
+
+    vector<string> lineas;
+    ifstream f(salida.c_str());
+    for ( string linea ; getline(f, linea) ; )
+      lineas.push_back(linea);
+    Comprobar(lineas == vector<string>(ref.begin(), ref.end()), "lineas ordenadas y sin repetir");
+
+    glob_t temporales;
+    Comprobar(glob((salida + ".??????").c_str(), 0, 0, &temporales) == GLOB_NOMATCH, "no quedan temporales");
+    globfree(&temporales);
+  }
+
+  ifstream f(ajeno.c_str());
+  string linea;
+  Comprobar(getline(f, linea) && linea == "no se toca", "los ficheros junto a la salida no se tocan");
+
+  Comprobar(!Refranes :: OrdenaFichero(entrada, "no_existe/salida", 10), "OrdenaFichero sin poder escribir");
+  Comprobar(!Refranes :: OrdenaFichero("comprueba_refranes.no_existe", salida, 10), "OrdenaFichero sin entrada");
+
+  remove(entrada);
+  remove(salida.c_str());
+  remove(ajeno.c_str());
+}
+
+
+/**
+ * @brief Comprueba ConPrefijo con prefijos mas cortos, iguales y mas largos
+ *        que len_prefijo, con y sin limite
+ */
+void TestConPrefijo () {
+
+  for ( int prueba = 0 ; prueba < 40 ; prueba++ ) {
+
+    int lpre = 1 + prueba % 4;
+    Refranes refs(lpre, prueba % 2 == 0 ? 0 : 3);
+    set<string> ref;
+
+    for ( int i = 0 ; i < 150 ; i++ ) {
+      string refran = RefranAleatorio(8);
+      refs.Insertar(refran);
+      if ( Cabe(refran, lpre) )
+        ref.insert(refran);
+    }
+
+    for ( int consulta = 0 ; consulta < 50 ; consulta++ ) {
+
+      // La mitad, las primeras letras de refranes que estan; el resto, al azar
+      string prefijo = RefranAleatorio(lpre + 3);
+      if ( !ref.empty() && rand() % 2 == 0 ) {
+        set<string> :: iterator it = ref.begin();
+        advance(it, rand() % ref.size());
+        size_t fin = 0;
+        for ( int letras = rand() % (lpre + 4) ; letras > 0 && fin < it->size() ; letras-- )
+          fin += Utf8 :: LongitudLetra(*it, fin);
+        prefijo = it->substr(0, fin);
+      }
+      int limite = rand() % 3 == 0 ? rand() % 5 : -1;
+
+      vector<string> esperados;
+      for ( set<string> :: iterator it = ref.lower_bound(prefijo) ; it != ref.end() && it->compare(0, prefijo.size(), prefijo) == 0 ; ++it )
+        if ( limite < 0 || (int)esperados.size() < limite )
+          esperados.push_back(*it);
+
+      vector<string> obtenidos;
+      Refranes :: Rango rango = refs.ConPrefijo(prefijo, limite);
+      for ( Refranes :: Rango :: iterator it = rango.begin() ; it != rango.end() ; ++it )
+        obtenidos.push_back(*it);
+
+      Comprobar(obtenidos == esperados, "ConPrefijo de \"" + prefijo + "\"");
+      Comprobar(rango.empty() == esperados.empty(), "empty() del rango");
+    }
+  }
+}
+
+
+/**
+ * @brief Cuenta las apariciones de una subcadena en un conjunto de referencia
+ * @param ref : conjunto de referencia
+ * @param patron : subcadena a contar, no vacia
+ */
+int Apariciones ( const set<string> &ref, const string &patron ) {
+
+  int n = 0;
+
+  for ( set<string> :: const_iterator it = ref.begin() ; it != ref.end() ; ++it )
+    for ( size_t p = it->find(patron) ; p != string :: npos ; p = it->find(patron, p + 1) )
+      n++;
+
+  return n;
+}
+
+
+/**
+ * @brief Comprueba el indice de subcadenas tras insertar y borrar: el numero
+ *        de apariciones y los refranes que recorre BuscaSubcadena
+ */
+void TestSubcadenas () {
+
+  for ( int prueba = 0 ; prueba < 20 ; prueba++ ) {
+
+    Refranes refs(1 + prueba % 3);
+    set<string> ref;
+    refs.IndexaSubcadenas(prueba % 4 != 3); // alguna prueba sin indice
+
+    for ( int paso = 0 ; paso < 120 ; paso++ ) {
+
+      string refran = RefranAleatorio(8);
+      if ( rand() % 4 != 0 ) {
+        refs.Insertar(refran);
+        if ( Cabe(refran, refs.getLen_prefijo()) )
+          ref.insert(refran);
+      }
+      else if ( !ref.empty() ) {
+        set<string> :: iterator it = ref.begin();
+        advance(it, rand() % ref.size());
+        refs.BorrarRefran(*it);
+        ref.erase(it);
+      }
+
+      if ( paso % 10 != 9 )
+        continue;
+
+      for ( int consulta = 0 ; consulta < 10 ; consulta++ ) {
+        string patron = RefranAleatorio(3);
+        if ( patron.empty() )
+          continue;
+
+        Comprobar(refs.CuentaSubcadena(patron) == Apariciones(ref, patron), "CuentaSubcadena de \"" + patron + "\"");
+
+        vector<string> esperados, obtenidos;
+        for ( set<string> :: iterator it = ref.begin() ; it != ref.end() ; ++it )
+          if ( it->find(patron) != string :: npos )
+            esperados.push_back(*it);
+
+        pair<bool, Refranes :: iterator> b = refs.BuscaSubcadena(patron);
+        while ( b.first && obtenidos.size() <= esperados.size() ) {
+          obtenidos.push_back(*b.second);
+          b = refs.BuscaSubcadena(patron, ++b.second);
+        }
+        Comprobar(obtenidos == esperados, "BuscaSubcadena de \"" + patron + "\"");
+      }
+
+      refs.PreparaLectura();
+      const Refranes &lectura = refs;
+      string patron = RefranAleatorio(2) + "a";
+      Comprobar(lectura.CuentaSubcadena(patron) == Apariciones(ref, patron), "CuentaSubcadena const");
+    }
+  }
+}
+
+
+/**
+ * @brief Comprueba IndiceSufijos::Primero con textos al azar y cualquier
+ *        texto de partida, tambien con muchos textos (varios bits por numero)
+ */
+void TestIndiceSufijos () {
+
+  for ( int prueba = 0 ; prueba < 10 ; prueba++ ) {
+
+    vector<string> textos(1 + rand() % (prueba < 5 ? 20 : 3000));
+    for ( size_t k = 0 ; k < textos.size() ; k++ )
+      textos[k] = RefranAleatorio(6);
+
+    IndiceSufijos indice;
+    indice.Construye(textos);
+
+    for ( int consulta = 0 ; consulta < 200 ; consulta++ ) {
+      string patron = RefranAleatorio(2);
+      int desde = rand() % (textos.size() + 1);
+
+      int esperado = -1;
+      for ( size_t k = desde ; k < textos.size() && esperado == -1 ; k++ )
+        if ( textos[k].find(patron) != string :: npos )
+          esperado = k;
+
+      Comprobar(indice.Primero(patron, desde) == esperado, "IndiceSufijos::Primero de \"" + patron + "\"");
+    }
+  }
+
+  IndiceSufijos vacio;
+  vacio.Construye(vector<string>());
+  Comprobar(vacio.Primero("a", 0) == -1 && vacio.Cuenta("a") == 0, "IndiceSufijos vacio");
+}
+
+
+/**
+ * @brief Guarda los refranes en binario, con y sin colas compartidas, y
+ *        comprueba que al cargarlos, o al consultarlos desde la proyeccion,
+ *        son los mismos
+ */
+void TestBinario () {
+
+  const char *fichero = "comprueba_refranes.bin";
+
+  for ( int prueba = 0 ; prueba < 20 ; prueba++ ) {
+
+    int lpre = 1 + prueba % 4;
+    int umbral = prueba % 4 == 0 ? 2 : 0;
+    Refranes refs(lpre, umbral);
+    set<string> ref;
+
+    for ( int i = 0 ; i < 100 * (prueba % 3) ; i++ ) {
+      string refran = RefranAleatorio(10);
+      refs.Insertar(refran);
+      if ( Cabe(refran, lpre) )
+        ref.insert(refran);
+    }
+
+    bool colas = prueba % 2 == 1;
+    Comprobar(refs.GuardaBinario(fichero, colas), "GuardaBinario");
+    Comprobar(refs.Caracteres_Colas() <= refs.Caracteres_Almacenados(), "las colas compartidas no ocupan mas");
+
+    // len_prefijo se deduce de las hojas: sin refranes se conserva el que habia
+    int otro = lpre == 1 ? 2 : 1;
+    Refranes cargados(otro);
+    Comprobar(cargados.CargaBinario(fichero), "CargaBinario");
+    Compara(cargados, ref, "tras CargaBinario");
+    if ( ref.empty() )
+      Comprobar(cargados.getLen_prefijo() == otro, "len_prefijo sin refranes");
+    else if ( umbral == 0 )
+      Comprobar(cargados.getLen_prefijo() == lpre, "len_prefijo del fichero");
+    Comprobar(cargados.Caracteres_Refranes() == refs.Caracteres_Refranes(), "caracteres tras CargaBinario");
+
+    // El cargado sigue admitiendo modificaciones
+    cargados.Insertar("refran nuevo");
+    Comprobar(cargados.Esta("refran nuevo").first, "Insertar tras CargaBinario");
+    if ( !ref.empty() ) {
+      cargados.BorrarRefran(*ref.begin());
+      Comprobar(!cargados.Esta(*ref.begin()).first, "BorrarRefran tras CargaBinario");
+    }
+
+    RefranesMapeados mapeados;
+    Comprobar(mapeados.Abrir(fichero), "RefranesMapeados::Abrir");
+    vector<string> v(ref.begin(), ref.end());
+    Comprobar(mapeados.size() == (int)v.size(), "size() de RefranesMapeados");
+    for ( int k = 0 ; k < mapeados.size() && k < (int)v.size() ; k++ )
+      Comprobar(mapeados.Refran(k) == v[k], "Refran de RefranesMapeados");
+  }
+
+  Refranes refs;
+  Comprobar(!refs.CargaBinario("comprueba_refranes.no_existe"), "CargaBinario de un fichero que no existe");
+
+  remove(fichero);
+}
+
+
+/**
+ * @brief Inserta y borra refranes al azar en un RefranesRadix y en un
+ *        Refranes con el mismo len_prefijo, y comprueba que tienen los mismos
+ *        refranes en el mismo orden y que el almacen no crece sin limite
+ * @note Algunos refranes empiezan por una e sin acento, para que una letra
+ *       sea el principio de los bytes de otra (e y e\u0301)
+ */
+void TestRadix () {
+
+  for ( int prueba = 0 ; prueba < 20 ; prueba++ ) {
+
+    int lpre = 1 + prueba % 4;
+    RefranesRadix refs(lpre);
+    Refranes trie(lpre);
+    set<string> ref;
+
+    for ( int paso = 0 ; paso < 2000 ; paso++ ) {
+
+      string refran = RefranAleatorio(8);
+      if ( rand() % 4 == 0 )
+        refran = "e" + refran;
+
+      if ( ref.size() < 100 && rand() % 2 == 0 ) {
+        refs.Insertar(refran);
+        trie.Insertar(refran);
+        if ( Cabe(refran, lpre) )
+          ref.insert(refran);
+      }
+      else if ( !ref.empty() ) {
+        set<string> :: iterator it = ref.begin();
+        advance(it, rand() % ref.size());
+        refs.BorrarRefran(*it);
+        trie.BorrarRefran(*it);
+        ref.erase(it);
+      }
+
+      Comprobar(refs.Esta(refran).first == (ref.count(refran) > 0), "Esta de RefranesRadix");
+      Comprobar(refs.Caracteres_Almacen() <= 2 * refs.Caracteres_Almacenados(), "el almacen de RefranesRadix no crece sin limite");
+    }
+
+    vector<string> v;
+    for ( RefranesRadix :: iterator it = refs.begin() ; it != refs.end() ; ++it )
+      v.push_back(*it);
+    Comprobar(refs.size() == (int)ref.size(), "size() de RefranesRadix");
+    Comprobar(v == Contenido(trie), "RefranesRadix recorre lo mismo que Refranes");
+  }
+}
+
+
+/**
+ * @brief Comprueba que Modificar publica los cambios, que una instantanea no
+ *        cambia mientras se conserva, que las versiones retiradas se
+ *        destruyen al soltarlas y que los lectores de otros hilos siempre ven
+ *        versiones completas
+ */
+void TestCompartidos () {
+
+  Refranes inicial(3);
+  inicial.Insertar("uno primero");
+  inicial.Insertar("dos segundo");
+  inicial.IndexaSubcadenas(true);
+
+  RefranesCompartidos compartidos(inicial);
+  inicial.Insertar("tres tercero"); // el original ya no se comparte
+  Comprobar(compartidos.Lector()->size() == 2, "RefranesCompartidos copia los refranes iniciales");
+
+  shared_ptr<const Refranes> viejo = compartidos.Lector();
+  compartidos.Modificar([](Refranes &r) {
+    r.Insertar("cuatro cuarto");
+    r.BorrarRefran("uno primero");
+  });
+
+  shared_ptr<const Refranes> nuevo = compartidos.Lector();
+  Comprobar(nuevo->Esta("cuatro cuarto").first && !nuevo->Esta("uno primero").first, "Modificar publica los cambios");
+  Comprobar(nuevo->CuentaSubcadena("cuarto") == 1, "Modificar deja el indice de subcadenas al dia");
+  Comprobar(viejo->size() == 2 && viejo->Esta("uno primero").first && !viejo->Esta("cuatro cuarto").first,
+            "una instantanea no cambia al modificar");
+  Comprobar(viejo->CuentaSubcadena("cuarto") == 0, "el indice de una instantanea no cambia");
+
+  // La version que se conserva no se destruye; la actual nunca se retira
+  Comprobar(compartidos.Retirados() == 1, "Retirados cuenta la version que se conserva");
+  viejo.reset();
+  Comprobar(compartidos.Retirados() == 0, "al soltarla se destruye");
+  nuevo.reset();
+
+  shared_ptr<const Refranes> a = compartidos.Lector();
+  compartidos.Modificar([](Refranes &r) { r.Insertar("cinco quinto"); });
+  shared_ptr<const Refranes> b = compartidos.Lector();
+  compartidos.Modificar([](Refranes &r) { r.Insertar("seis sexto"); });
+  Comprobar(compartidos.Retirados() == 2, "Retirados con dos versiones en uso");
+  a.reset();
+  Comprobar(compartidos.Retirados() == 1, "se destruye la primera que se suelta");
+  b.reset();
+  Comprobar(compartidos.Retirados() == 0, "y despues todas");
+  Comprobar(compartidos.Lector()->size() == 4, "la version actual tiene todos los cambios");
+
+  // Cada cambio inserta una pareja: ningun lector puede ver solo la mitad
+  atomic<bool> terminado(false);
+  atomic<int> incompletas(0), lecturas(0);
+  vector<thread> lectores;
+
+  for ( int h = 0 ; h < 4 ; h++ )
+    lectores.push_back(thread([&]() {
+      while ( !terminado ) {
+        shared_ptr<const Refranes> v = compartidos.Lector();
+        int n = v->size();
+        for ( int k = 0 ; k < 50 ; k++ )
+          if ( v->Esta("par " + to_string(k)).first != v->Esta("impar " + to_string(k)).first )
+            incompletas++;
+        if ( v->size() != n || n % 2 != 0 )
+          incompletas++;
+        lecturas++;
+      }
+    }));
+
+  for ( int k = 0 ; k < 50 ; k++ )
+    compartidos.Modificar([k](Refranes &r) {
+      r.Insertar("par " + to_string(k));
+      r.Insertar("impar " + to_string(k));
+    });
+
+  while ( lecturas < 100 )
+    this_thread :: yield();
+  terminado = true;
+  for ( size_t h = 0 ; h < lectores.size() ; h++ )
+    lectores[h].join();
+
+  Comprobar(incompletas == 0, "los lectores ven cada cambio entero o nada");
+  Comprobar(compartidos.Lector()->size() == 104, "los cambios de Modificar se acumulan");
+  Comprobar(compartidos.Retirados() == 0, "sin lectores no queda ninguna version retirada");
+}
+
+
+/**
+ * @brief Todas las lineas que devuelve un LectorLineas
+ * @param entrada : contenido del flujo
+ * @param minusc, sin_acentos : opciones del lector
+ * @param leidos : al terminar, los caracteres que dice haber leido
+ */
+vector<string> Lineas ( const string &entrada, bool minusc, bool sin_acentos, size_t &leidos ) {
+
+  istringstream is(entrada);
+  LectorLineas lector(is, minusc, sin_acentos);
+  vector<string> v;
+
+  while ( lector.Siguiente() )
+    v.push_back(lector.Linea());
+
+  Comprobar(is.eof(), "el flujo queda en eof");
+  leidos = lector.Leidos();
+  return v;
+}
+
+
+/**
+ * @brief Comprueba que LectorLineas limpia los finales de linea, salta las
+ *        lineas vacias y une las que quedan entre dos bloques
+ */
+void TestLectorLineas () {
+
+  struct Caso { string entrada; bool minusc, sin_acentos; vector<string> lineas; };
+
+  const size_t BLOQUE = 1 << 16; // LectorLineas :: TAM_BLOQUE
+  string larga(BLOQUE + 100, 'x');
+  string antes(BLOQUE - 5, 'y');   // la siguiente linea empieza 4 bytes antes del fin del bloque
+  string justo(BLOQUE - 2, 'z');   // la 'É' de la siguiente linea queda partida entre dos bloques
+
+  const Caso casos[] = {
+    { "", false, false, {} },
+    { "uno\ndos\n", false, false, { "uno", "dos" } },
+    { "uno\ndos", false, false, { "uno", "dos" } }, // sin '\n' al final
+    { "uno\r\ndos\r\n", false, false, { "uno", "dos" } }, // CRLF
+    { "uno \t \r\ndos\t\n", false, false, { "uno", "dos" } }, // espacios al final
+    { " uno", false, false, { " uno" } }, // los del principio se quedan
+    { "\n\n \n\t\r\n\r\nuno\n \t", false, false, { "uno" } }, // lineas en blanco
+    { "\xc3\x81RBOL \r\n", true, false, { "\xc3\xa1rbol" } },
+    { "\xc3\x81RBOL \r\n", true, true, { "arbol" } },
+    { larga + "\nfin", false, false, { larga, "fin" } }, // mas larga que un bloque
+    { antes + "\nabcdefgh\r\n", false, false, { antes, "abcdefgh" } }, // partida entre bloques
+    { antes + "\nabc\r\n", false, false, { antes, "abc" } }, // '\r' y '\n' en bloques distintos
+    { justo + "\n\xc3\x89L\n", true, false, { justo, "\xc3\xa9l" } } // letra partida entre bloques
+  };
+
+  for ( size_t i = 0 ; i < sizeof(casos) / sizeof(Caso) ; i++ ) {
+    size_t leidos;
+    vector<string> v = Lineas(casos[i].entrada, casos[i].minusc, casos[i].sin_acentos, leidos);
+    Comprobar(v == casos[i].lineas, "lineas del caso " + to_string(i) + " de LectorLineas");
+    Comprobar(leidos == casos[i].entrada.size(), "Leidos del caso " + to_string(i) + " de LectorLineas");
+  }
+}
+
+
+/**
+ * @brief Comprueba Minusculas, QuitaAcentos y el recuento de letras con
+ *        tablas de entradas y salidas esperadas
+ */
+void TestUtf8 () {
+
+  struct Caso { const char *entrada, *salida; };
+
+  const Caso minusculas[] = {
+    { "ABC xyz", "abc xyz" },
+    { "\xc3\x81\xc3\x89\xc3\x91\xc3\x87", "\xc3\xa1\xc3\xa9\xc3\xb1\xc3\xa7" }, // ÁÉÑÇ
+    { "\xc3\x80\xc3\x9e", "\xc3\xa0\xc3\xbe" }, // ÀÞ
+    { "\xc3\x97", "\xc3\x97" }, // × se queda
+    { "\xc3\x9f\xc3\xa1", "\xc3\x9f\xc3\xa1" }, // ß y á se quedan
+    { "E\xcc\x81", "e\xcc\x81" }, // E + acento
+    { "\xe2\x82\xac", "\xe2\x82\xac" }, // €
+    { "Z\xc3", "z\xc3" } // cortada al final
+  };
+
+  for ( size_t i = 0 ; i < sizeof(minusculas) / sizeof(Caso) ; i++ ) {
+    string cad = minusculas[i].entrada;
+    Utf8 :: Minusculas(cad);
+    Comprobar(cad == minusculas[i].salida, "Minusculas de \"" + string(minusculas[i].entrada) + "\"");
+  }
+
+  const Caso sin_acentos[] = {
+    { "r\xc3\xad" "e", "rie" }, // ríe
+    { "\xc3\x81\xc3\x89\xc3\x8d\xc3\x93\xc3\x9a\xc3\x9c", "AEIOUU" }, // ÁÉÍÓÚÜ
+    { "\xc3\xa0\xc3\xa7\xc3\xaa\xc3\xaf\xc3\xb5\xc3\xbf", "aceioy" }, // àçêïõÿ
+    { "\xc3\xb1\xc3\x91", "\xc3\xb1\xc3\x91" }, // ñÑ se quedan
+    { "n\xcc\x83", "\xc3\xb1" }, // n + tilde es ñ
+    { "N\xcc\x83o", "\xc3\x91o" }, // N + tilde es Ñ
+    { "e\xcc\x81u\xcc\x88", "eu" }, // marcas sueltas
+    { "a\xcc\x83", "a" }, // tilde sobre otra letra
+    { "\xcc\x83", "" }, // tilde sin letra
+    { "\xc3\x97\xc3\x86\xc3\x9f\xc3\xb7", "\xc3\x97\xc3\x86\xc3\x9f\xc3\xb7" }, // ×Æß÷ se quedan
+    { "\xe2\x82\xac\xc3", "\xe2\x82\xac\xc3" } // € y cortada al final
+  };
+
+  for ( size_t i = 0 ; i < sizeof(sin_acentos) / sizeof(Caso) ; i++ ) {
+    string cad = sin_acentos[i].entrada;
+    Utf8 :: QuitaAcentos(cad);
+    Comprobar(cad == sin_acentos[i].salida, "QuitaAcentos de \"" + string(sin_acentos[i].entrada) + "\"");
+  }
+
+  struct Letra { const char *cad; size_t pos, longitud; };
+
+  const Letra letras[] = {
+    { "abc", 1, 1 },
+    { "\xc3\xb1", 0, 2 }, // ñ
+    { "e\xcc\x81x", 0, 3 }, // e + acento
+    { "u\xcc\x88\xcc\x81", 0, 5 }, // u + dos marcas
+    { "\xe2\x82\xac", 0, 3 }, // €
+    { "\xf0\x9f\x98\x80", 0, 4 }, // emoji
+    { "\xc3", 0, 1 }, // cortada
+    { "\xc3" "a", 0, 1 }, // mal formada
+    { "\xcc\x81", 0, 2 } // marca sin letra
+  };
+
+  for ( size_t i = 0 ; i < sizeof(letras) / sizeof(Letra) ; i++ )
+    Comprobar(Utf8 :: LongitudLetra(letras[i].cad, letras[i].pos) == letras[i].longitud,
+              "LongitudLetra de \"" + string(letras[i].cad) + "\"");
+
+  Comprobar(Utf8 :: Letras("\xc3\xb1" "e\xcc\x81" "a", 10) == 3, "Letras cuenta letras, no bytes");
+  Comprobar(Utf8 :: Letras("\xc3\xb1" "e\xcc\x81" "a", 2) == 2, "Letras se para en el maximo");
+  Comprobar(Utf8 :: Letras("", 3) == 0, "Letras de la cadena vacia");
+}
+
+
+
+int main () {
+
+  srand(1);
+
+  TestInsertar();
+  TestEsta();
+  TestBorrar();
+  TestAleatorio();
+  TestBuildFromSorted();
+  TestOrdenaFichero();
+  TestBinario();
+  TestSubcadenas();
+  TestIndiceSufijos();
+  TestConPrefijo();
+  TestUtf8();
+  TestLectorLineas();
+  TestCompartidos();
+  TestRadix();
+
+  if ( fallos == 0 )
+    cout << " comprueba_refranes : OK" << endl;
+  else
+    cout << " comprueba_refranes : " << fallos << " fallos" << endl;
+
+  return fallos == 0 ? 0 : 1;
+}
@@ -0,0 +1,220 @@
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include <random>
+#include "refranes_hash.h"
+
+using namespace std;
+
+
+/**
+ * @file comprueba_refranes_hash.cpp
+ * @author Gregorio Vidoy Fajardo y Jesus Ruiz Castellano
+ * @date 24 de Enero de 2017, 12:15
+ * @brief Fichero con las pruebas automaticas del TDA Refranes con tabla
+ *        hash. Cada prueba compara el conjunto con un set<string> que hace
+ *        de referencia
+ */
+
+
+int fallos = 0; // Numero de comprobaciones fallidas
+
+
+/**
+ * @brief Anota un fallo si no se cumple la condicion
+ * @param cond : condicion a comprobar
+ * @param msg : descripcion de la comprobacion
+ */
+void Comprobar ( bool cond, const string &msg ) {
+
+  if ( !cond ) {
+    cout << " FALLO : " << msg << endl;
+    fallos++;
+  }
+}
+
+
+/**
+ * @brief Construye un refran aleatorio con pocas letras distintas, para que
+ *        se repitan los primeros caracteres con los que se calcula el hash
+ * @param maximo : numero maximo de letras
+ */
+string RefranAleatorio ( int maximo ) {
+
+  string refran;
+  int n = 1 + rand() % maximo;
+
+  for ( int i = 0 ; i < n ; i++ )
+    refran += "abc "[rand() % 4];
+
+  return refran;
+}
+
+
+/**
+ * @brief Comprueba el conjunto contra la referencia: tamaño, Esta de todos
+ *        y recorrido sin repetidos
+ * @param refs : conjunto a comprobar
+ * @param ref : conjunto de referencia
+ * @param msg : descripcion del paso
+ */
+void Compara ( Refranes &refs, const set<string> &ref, const string &msg ) {
+
+  set<string> recorridos;
+  int n = 0;
+
+  for ( Refranes :: const_iterator it = refs.Cbegin() ; it != refs.Cend() ; ++it, n++ )
+    recorridos.insert(*it);
+
+  bool estan = true;
+  for ( set<string> :: const_iterator it = ref.begin() ; it != ref.end() ; ++it )
+    estan = estan && refs.Esta(*it).first;
+
+  Comprobar(refs.size() == (int)ref.size(), "size() " + msg);
+  Comprobar(n == (int)ref.size() && recorridos == ref, "recorrido " + msg);
+  Comprobar(estan, "Esta de todos " + msg);
+}
+
+
+/**
+ * @brief Sortea muchas veces un refran y comprueba que salen todos los de la
+ *        referencia, ninguno mas, y cada uno un numero de veces parecido
+ * @param refs : conjunto del que se sortea, con los refranes de ref
+ * @param ref : conjunto de referencia, no vacio
+ * @param gen : generador para Aleatorio
+ * @param msg : descripcion del paso
+ * @note Con 2000 sorteos por refran la desviacion de cada cuenta es de unos
+ *       45; se admite un 20%, unas 9 desviaciones
+ */
+void CompruebaSorteo ( const Refranes &refs, const set<string> &ref, mt19937 &gen, const string &msg ) {
+
+  const int VECES = 2000;
+  map<string, int> cuenta;
+
+  for ( size_t i = 0 ; i < VECES * ref.size() ; i++ )
+    cuenta[refs.Aleatorio(gen)]++;
+
+  bool todos = cuenta.size() == ref.size(), parecidos = true;
+  for ( map<string, int> :: iterator it = cuenta.begin() ; it != cuenta.end() ; ++it ) {
+    todos = todos && ref.count(it->first) > 0;
+    parecidos = parecidos && it->second > VECES * 0.8 && it->second < VECES * 1.2;
+  }
+
+  Comprobar(todos, "Aleatorio saca todos los refranes y solo ellos " + msg);
+  Comprobar(parecidos, "Aleatorio saca cada refran con la misma probabilidad " + msg);
+}
+
+
+/**
+ * @brief Inserta y borra refranes al azar, con muchos que comparten hash, y
+ *        comprueba el conjunto tras cada paso y los sorteos al final
+ */
+void TestInsertarBorrar () {
+
+  mt19937 gen(1);
+
+  for ( int prueba = 0 ; prueba < 10 ; prueba++ ) {
+
+    Refranes refs;
+    set<string> ref;
+
+    for ( int paso = 0 ; paso < 300 ; paso++ ) {
+
+      string refran = RefranAleatorio(6);
+      if ( rand() % 3 != 0 ) {
+        refs.Insertar(refran);
+        ref.insert(refran);
+      }
+      else {
+        if ( !ref.empty() && rand() % 2 == 0 ) { // uno que esta
+          set<string> :: iterator it = ref.begin();
+          advance(it, rand() % ref.size());
+          refran = *it;
+        }
+        refs.BorrarRefran(refran);
+        ref.erase(refran);
+      }
+
+      Comprobar(refs.Esta(refran).first == (ref.count(refran) > 0), "Esta del refran modificado");
+    }
+
+    Compara(refs, ref, "tras insertar y borrar");
+    if ( !ref.empty() )
+      CompruebaSorteo(refs, ref, gen, "tras insertar y borrar");
+  }
+}
+
+
+/**
+ * @brief Comprueba que las copias y asignaciones sortean entre sus propios
+ *        refranes, tambien despues de modificar el original, y que tras
+ *        clear se vuelve a sortear bien
+ */
+void TestCopias () {
+
+  mt19937 gen(2);
+  Refranes refs;
+  set<string> ref;
+
+  while ( ref.size() < 50 ) {
+    string refran = RefranAleatorio(8);
+    refs.Insertar(refran);
+    ref.insert(refran);
+  }
+
+  Refranes copia(refs);
+  Refranes asignado;
+  asignado.Insertar("refran que se pierde al asignar");
+  asignado = refs;
+
+  // Borrar en el original no toca los punteros de las copias
+  set<string> quedan;
+  for ( set<string> :: iterator it = ref.begin() ; it != ref.end() ; ++it )
+    if ( rand() % 2 == 0 )
+      refs.BorrarRefran(*it);
+    else
+      quedan.insert(*it);
+  refs.Insertar("refran nuevo");
+  quedan.insert("refran nuevo");
+
+  Compara(refs, quedan, "en el original");
+  CompruebaSorteo(refs, quedan, gen, "en el original");
+  Compara(copia, ref, "en la copia");
+  CompruebaSorteo(copia, ref, gen, "en la copia");
+  Compara(asignado, ref, "tras asignar");
+  CompruebaSorteo(asignado, ref, gen, "tras asignar");
+
+  // Y borrar en la copia no toca el original
+  copia.BorrarRefran(*quedan.begin());
+  CompruebaSorteo(refs, quedan, gen, "tras borrar en la copia");
+
+  refs.clear();
+  set<string> nuevos;
+  nuevos.insert("uno");
+  nuevos.insert("dos");
+  refs.Insertar("uno");
+  refs.Insertar("dos");
+  Compara(refs, nuevos, "tras clear");
+  CompruebaSorteo(refs, nuevos, gen, "tras clear");
+}
+
+
+
+int main () {
+
+  srand(1);
+
+  TestInsertarBorrar();
+  TestCopias();
+
+  if ( fallos == 0 )
+    cout << " comprueba_refranes_hash : OK" << endl;
+  else
+    cout << " comprueba_refranes_hash : " << fallos << " fallos" << endl;
+
+  return fallos == 0 ? 0 : 1;
+}
@@ -0,0 +1,98 @@
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+#include "refranes.h"
+#include "ArbolMapeado.h"
+
+using namespace std;
+
+
+/**
+ * @file convierte_arbol.cpp
+ * @author Gregorio Vidoy Fajardo y Jesus Ruiz Castellano
+ * @date 24 de enero de 2017, 20:10
+ * @brief Conversion entre el formato de texto de ArbolGeneral y el formato
+ *        binario de ArbolMapeado
+ */
+
+
+/**
+ * @brief Muestra los parametros del programa
+ */
+void Uso () {
+  cout << "\n Los parametros son : " << endl;
+  cout << " 1.- Modo de conversion:" << endl;
+  cout << "       -b : arbol en texto  -> binario" << endl;
+  cout << "       -t : binario         -> arbol en texto" << endl;
+  cout << "       -r : fichero de refranes -> binario (para adivina)" << endl;
+  cout << "       -c : como -r, compartiendo los finales iguales de las etiquetas" << endl;
+  cout << " 2.- Fichero de entrada" << endl;
+  cout << " 3.- Fichero de salida" << endl;
+  cout << " 4.- [Opcional, solo -r y -c] Prefijo de los refranes (por defecto 3)" << endl << endl;
+}
+
+
+
+int main ( int argc, char** argv ) {
+
+  if ( argc != 4 && argc != 5 ) {
+    Uso();
+    return 0;
+  }
+
+  string modo = argv[1];
+  string entrada = argv[2];
+  string salida = argv[3];
+
+  if ( modo == "-b" ) {
+    ifstream fin ( entrada.c_str() );
+    if ( !fin ) {
+      cout << "\n No puedo abrir el fichero " << entrada << endl;
+      return 1;
+    }
+    ArbolGeneral<string> ab;
+    fin >> ab;
+
+    ofstream fout ( salida.c_str(), ios::binary );
+    if ( !fout || !ArbolMapeado :: Escribir(fout, ab.freeze()) ) {
+      cout << "\n No puedo escribir el fichero " << salida << endl;
+      return 1;
+    }
+  }
+  else if ( modo == "-t" ) {
+    ArbolMapeado mapa;
+    if ( !mapa.Abrir(entrada) ) {
+      cout << "\n El fichero " << entrada << " no tiene formato binario valido" << endl;
+      return 1;
+    }
+    ArbolGeneral<string> ab;
+    mapa.Volcar(ab);
+
+    ofstream fout ( salida.c_str() );
+    if ( !(fout << ab) ) {
+      cout << "\n No puedo escribir el fichero " << salida << endl;
+      return 1;
+    }
+  }
+  else if ( modo == "-r" || modo == "-c" ) {
+    ifstream fin ( entrada.c_str() );
+    if ( !fin ) {
+      cout << "\n No puedo abrir el fichero " << entrada << endl;
+      return 1;
+    }
+    Refranes refs ( argc == 5 ? atoi(argv[4]) : 3 );
+    fin >> refs;
+
+    if ( !refs.GuardaBinario(salida, modo == "-c") ) {
+      cout << "\n No puedo escribir el fichero " << salida << endl;
+      return 1;
+    }
+  }
+  else {
+    Uso();
+    return 0;
+  }
+
+  return 0;
+}
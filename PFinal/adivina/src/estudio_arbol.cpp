@@ -0,0 +1,240 @@
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <chrono>
+#include "ArbolGeneral.h"
+
+using namespace std;
+
+
+/**
+ * @file estudio_arbol.cpp
+ * @author Gregorio Vidoy Fajardo y Jesus Ruiz Castellano
+ * @date 14 de Diciembre de 2016, 18:15
+ * @brief Fichero con el estudio de tiempos del TDA ArbolGeneral
+ */
+
+
+/**
+ * @brief Reloj usado en todas las mediciones
+ */
+typedef chrono :: steady_clock Reloj;
+
+
+/**
+ * @brief Milisegundos transcurridos entre dos instantes
+ */
+double Milisegundos ( Reloj :: time_point ini, Reloj :: time_point fin ) {
+  return chrono :: duration<double, milli>(fin - ini).count();
+}
+
+
+/**
+ * @brief Construye un arbol de n nodos con la misma forma que el de Refranes:
+ *        cada nodo tiene hasta 26 hijos, insertados uno a uno por niveles
+ * @param ab : arbol a construir, se vacia antes
+ * @param n : numero de nodos
+ * @param mover : si es true cada nodo se inserta sin copia
+ */
+template <template <class> class A>
+void Construir ( ArbolGeneral<string,A> &ab, int n, bool mover = false ) {
+
+  typedef typename ArbolGeneral<string,A> :: Nodo Nodo;
+
+  ab.AsignaRaiz("");
+  queue<Nodo> pendientes; // nodos que aun no tienen hijos
+  pendientes.push(ab.Raiz());
+  int hijos = 0;
+
+  for ( int i = 1 ; i < n ; i++ ) {
+    ArbolGeneral<string,A> rama ( string(1, 'a' + hijos) );
+    if ( mover )
+      ab.Insertar_hijoMasIzquierda(pendientes.front(), std::move(rama));
+    else
+      ab.Insertar_hijoMasIzquierda(pendientes.front(), rama);
+    pendientes.push(ab.HijoMasIzquierda(pendientes.front()));
+
+    if ( ++hijos == 26 ) {
+      pendientes.pop();
+      hijos = 0;
+    }
+  }
+}
+
+
+/**
+ * @brief Mide la carga, copia y borrado de un arbol con la politica A, y
+ *        la memoria que se queda la politica al borrarlo
+ * @param nombre : nombre de la politica para la tabla
+ * @param n : numero de nodos del arbol
+ */
+template <template <class> class A>
+void EstudioAsignador ( const string &nombre, int n ) {
+
+  ArbolGeneral<string,A> ab;
+
+  Reloj :: time_point t0 = Reloj :: now();
+  Construir(ab, n);
+  Reloj :: time_point t1 = Reloj :: now();
+  ArbolGeneral<string,A> copia(ab);
+  Reloj :: time_point t2 = Reloj :: now();
+  copia.Clear();
+  ab.Clear();
+  Reloj :: time_point t3 = Reloj :: now();
+
+  cout << nombre << ";" << n << ";"
+       << Milisegundos(t0,t1) << ";"
+       << Milisegundos(t1,t2) << ";"
+       << Milisegundos(t2,t3) << ";"
+       << ArbolGeneral<string,A> :: HolguraAsignador() << endl;
+}
+
+
+/**
+ * @brief Mide la construccion de un arbol insertando con copia y sin copia
+ * @param n : numero de nodos del arbol
+ */
+void EstudioInsercion ( int n ) {
+
+  for ( int mover = 0 ; mover <= 1 ; mover++ ) {
+    ArbolGeneral<string> ab;
+
+    Reloj :: time_point t0 = Reloj :: now();
+    Construir(ab, n, mover);
+    Reloj :: time_point t1 = Reloj :: now();
+
+    cout << ( mover ? "Movimiento" : "Copia" ) << ";" << n << ";"
+         << Milisegundos(t0,t1) << endl;
+  }
+}
+
+
+/**
+ * @brief Mide un recorrido completo en preorden sobre el arbol enlazado y
+ *        sobre su copia aplanada
+ * @param n : numero de nodos del arbol
+ */
+void EstudioPlano ( int n ) {
+
+  ArbolGeneral<string> ab;
+  Construir(ab, n, true);
+
+  size_t total = 0;
+  Reloj :: time_point t0 = Reloj :: now();
+  for ( ArbolGeneral<string> :: const_iter_preorden it = ab.cbegin() ; it != ab.cend() ; ++it )
+    total += (*it).size();
+  Reloj :: time_point t1 = Reloj :: now();
+
+  ArbolPlano<string> plano = ab.freeze();
+
+  Reloj :: time_point t2 = Reloj :: now();
+  for ( ArbolPlano<string> :: const_iter_preorden it = plano.cbegin() ; it != plano.cend() ; ++it )
+    total -= (*it).size();
+  Reloj :: time_point t3 = Reloj :: now();
+
+  cout << "Enlazado;" << n << ";" << Milisegundos(t0,t1) << endl;
+  cout << "Plano;" << n << ";" << Milisegundos(t2,t3) << endl;
+  cout << "freeze();" << n << ";" << Milisegundos(t1,t2) << endl;
+
+  if ( total != 0 )
+    cout << "Los recorridos no coinciden" << endl;
+}
+
+
+/**
+ * @brief Mide un recorrido completo del arbol enlazado en preorden, en
+ *        postorden y por niveles
+ * @param n : numero de nodos del arbol
+ */
+void EstudioRecorridos ( int n ) {
+
+  typedef ArbolGeneral<string> Arbol;
+
+  Arbol ab;
+  Construir(ab, n, true);
+
+  size_t pre = 0, post = 0, niveles = 0;
+
+  Reloj :: time_point t0 = Reloj :: now();
+  for ( Arbol :: const_iter_preorden it = ab.cbegin() ; it != ab.cend() ; ++it )
+    pre += (*it).size() + it.getLevel();
+  Reloj :: time_point t1 = Reloj :: now();
+  for ( Arbol :: const_iter_postorden it = ab.cbegin_postorden() ; it != ab.cend_postorden() ; ++it )
+    post += (*it).size() + it.getLevel();
+  Reloj :: time_point t2 = Reloj :: now();
+  for ( Arbol :: const_iter_nivel it = ab.cbegin_nivel() ; it != ab.cend_nivel() ; ++it )
+    niveles += (*it).size() + it.getLevel();
+  Reloj :: time_point t3 = Reloj :: now();
+
+  cout << "Preorden;" << n << ";" << Milisegundos(t0,t1) << endl;
+  cout << "Postorden;" << n << ";" << Milisegundos(t1,t2) << endl;
+  cout << "Niveles;" << n << ";" << Milisegundos(t2,t3) << endl;
+
+  if ( pre != post || pre != niveles )
+    cout << "Los recorridos no coinciden" << endl;
+}
+
+
+/**
+ * @brief Mide la copia y el borrado de un arbol con 1, 2, 4 y 8 hilos
+ * @param n : numero de nodos del arbol
+ */
+void EstudioHilos ( int n ) {
+
+  typedef ArbolGeneral<string> Arbol;
+
+  int hilos = Arbol :: Hilos();
+  Arbol ab;
+  Construir(ab, n, true);
+
+  for ( int h = 1 ; h <= 8 ; h *= 2 ) {
+    Arbol :: Hilos(h);
+
+    Reloj :: time_point t0 = Reloj :: now();
+    Arbol copia(ab);
+    Reloj :: time_point t1 = Reloj :: now();
+    copia.Clear();
+    Reloj :: time_point t2 = Reloj :: now();
+
+    cout << h << ";" << n << ";"
+         << Milisegundos(t0,t1) << ";"
+         << Milisegundos(t1,t2) << endl;
+  }
+
+  Arbol :: Hilos(hilos);
+}
+
+
+
+int main ( int argc, char** argv ) {
+
+  int n = 1000000;
+
+  if ( argc == 2 )
+    n = atoi(argv[1]);
+  else if ( argc > 2 ) {
+    cout << "\n Los parametros son : " << endl;
+    cout << " 1.- [Opcional] Numero de nodos del arbol (por defecto 1000000)" << endl << endl;
+    return 0;
+  }
+
+  cout << "Asignador;#Nodos;Carga(ms);Copia(ms);Borrado(ms);Holgura(bytes)" << endl;
+  EstudioAsignador<AsignadorHeap> ("Heap", n);
+  EstudioAsignador<AsignadorPool> ("Pool", n);
+  // Segunda pasada del pool: los bloques ya estan reservados
+  EstudioAsignador<AsignadorPool> ("Pool(reuso)", n);
+
+  cout << endl << "Insercion;#Nodos;Carga(ms)" << endl;
+  EstudioInsercion(n);
+
+  cout << endl << "Preorden;#Nodos;Recorrido(ms)" << endl;
+  EstudioPlano(n);
+
+  cout << endl << "Recorrido;#Nodos;Tiempo(ms)" << endl;
+  EstudioRecorridos(n);
+
+  cout << endl << "Hilos;#Nodos;Copia(ms);Borrado(ms)" << endl;
+  EstudioHilos(n);
+
+  return 0;
+}
@@ -0,0 +1,397 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <string>
+#include <chrono>
+#include <new>
+#include <vector>
+#include <cstdio>
+#include "refranes.h"
+#include "LectorLineas.h"
+
+using namespace std;
+
+
+/**
+ * @file estudio_carga.cpp
+ * @author Gregorio Vidoy Fajardo y Jesus Ruiz Castellano
+ * @date 25 de enero de 2017, 17:40
+ * @brief Fichero con el estudio de tiempos y reservas de memoria al
+ *        cargar un conjunto de refranes
+ */
+
+
+size_t reservas = 0; // Numero de llamadas a operator new
+
+void* operator new ( size_t n ) {
+
+  reservas++;
+  void *p = malloc(n);
+
+  if ( p == 0 )
+    throw bad_alloc();
+
+  return p;
+}
+
+void operator delete ( void *p ) noexcept {
+  free(p);
+}
+
+void operator delete ( void *p, size_t ) noexcept {
+  free(p);
+}
+
+
+/**
+ * @brief Genera un corpus con los refranes de un fichero repetidos varias
+ *        veces. Cada repeticion lleva un numero al final para que todos los
+ *        refranes sean distintos
+ * @param fin : fichero con los refranes originales
+ * @param factor : numero de repeticiones
+ * @return El corpus generado, un refran por linea
+ */
+string Escalar ( istream &fin, int factor ) {
+
+  string original, linea;
+
+  while ( getline(fin, linea) )
+    if ( !linea.empty() )
+      original += linea + "\n";
+
+  string corpus;
+  for ( int k = 0 ; k < factor ; k++ ) {
+    istringstream is(original);
+    while ( getline(is, linea) ) {
+      if ( !corpus.empty() )
+        corpus += "\n";
+      corpus += linea;
+      if ( k > 0 )
+        corpus += " " + to_string(k);
+    }
+  }
+
+  return corpus;
+}
+
+
+/**
+ * @brief Genera refranes sinteticos: entre 3 y 7 palabras tomadas de un
+ *        vocabulario aleatorio de 2000 palabras
+ * @param n : numero de refranes
+ * @return Los refranes generados
+ */
+vector<string> Sinteticos ( int n ) {
+
+  vector<string> vocabulario;
+  for ( int i = 0 ; i < 2000 ; i++ ) {
+    string palabra;
+    for ( int l = 2 + rand() % 7 ; l > 0 ; l-- )
+      palabra.push_back('a' + rand() % 26);
+    vocabulario.push_back(palabra);
+  }
+
+  vector<string> refranes;
+  for ( int i = 0 ; i < n ; i++ ) {
+    string refran;
+    for ( int p = 3 + rand() % 5 ; p > 0 ; p-- ) {
+      if ( !refran.empty() )
+        refran += " ";
+      refran += vocabulario[rand() % vocabulario.size()];
+    }
+    refranes.push_back(refran);
+  }
+
+  return refranes;
+}
+
+
+/**
+ * @brief Inserta un refran como lo hacia la primera version de Refranes:
+ *        por cada letra del prefijo recorre el arbol entero desde la raiz,
+ *        reconstruyendo con padre el prefijo de cada candidato, y antes
+ *        busca el refran recorriendo todas las hojas
+ * @param ab : arbol de refranes, con raiz ""
+ * @param len : longitud del prefijo
+ * @param refran : refran a insertar
+ * @note Solo sirve como referencia para comparar tiempos
+ */
+void InsertarRecorrido ( ArbolGeneral<string> &ab, int len, const string &refran ) {
+
+  typedef ArbolGeneral<string> :: iter_preorden Iter;
+
+  // Busqueda del refran entre todas las hojas
+  for ( Iter it = ab.begin() ; it != ab.end() ; ++it )
+    if ( it.Hoja() && it.GetNodo() != ab.Raiz() ) {
+      string cad;
+      for ( ArbolGeneral<string> :: Nodo n = it.GetNodo() ; ab.Padre(n) != 0 ; n = ab.Padre(n) )
+        cad.insert(0, ab.Etiqueta(n));
+      if ( cad.find(refran) != string :: npos )
+        return;
+    }
+
+  ArbolGeneral<string> :: Nodo ultimo = ab.Raiz();
+
+  for ( int i = 0 ; i < len ; i++ ) {
+    string letra(1, refran[i]);
+    bool encontrado = false;
+
+    for ( Iter it = ab.begin() ; it != ab.end() && !encontrado ; ++it )
+      if ( it.getLevel() == i && *it == letra ) {
+        string letrasPadre;
+        for ( ArbolGeneral<string> :: Nodo n = ab.Padre(it.GetNodo()) ; n != 0 ; n = ab.Padre(n) )
+          letrasPadre.insert(0, ab.Etiqueta(n));
+        if ( letrasPadre == refran.substr(0, i) ) {
+          encontrado = true;
+          ultimo = it.GetNodo();
+        }
+      }
+
+    if ( !encontrado ) {
+      ab.Insertar_hijoMasIzquierda(ultimo, ArbolGeneral<string>(letra));
+      ultimo = ab.HijoMasIzquierda(ultimo);
+    }
+  }
+
+  ab.Insertar_hijoMasIzquierda(ultimo, ArbolGeneral<string>(refran.substr(len)));
+}
+
+
+/**
+ * @brief Compara la carga de refranes sinteticos bajando por el arbol
+ *        (Refranes::Insertar) y recorriendolo entero (InsertarRecorrido)
+ * @param n : numero maximo de refranes
+ * @param len : longitud del prefijo
+ */
+void EstudioSinteticos ( int n, int len ) {
+
+  vector<string> refranes = Sinteticos(n);
+
+  cout << "Metodo;#Refranes;#Nodos;Carga(ms)" << endl;
+
+  for ( int m = 1000 ; m <= n ; m *= 10 ) {
+    Refranes refs(len);
+    chrono :: steady_clock :: time_point t0 = chrono :: steady_clock :: now();
+    for ( int i = 0 ; i < m ; i++ )
+      refs.Insertar(refranes[i]);
+    chrono :: steady_clock :: time_point t1 = chrono :: steady_clock :: now();
+
+    cout << "Descenso;" << m << ";" << refs.Numero_Nodos() << ";"
+         << chrono :: duration<double, milli>(t1 - t0).count() << endl;
+
+    // El recorrido completo es cuadratico: solo se mide en los tamaños pequeños
+    if ( m <= 10000 ) {
+      ArbolGeneral<string> ab("");
+      t0 = chrono :: steady_clock :: now();
+      for ( int i = 0 ; i < m ; i++ )
+        InsertarRecorrido(ab, len, refranes[i]);
+      t1 = chrono :: steady_clock :: now();
+
+      cout << "Recorrido;" << m << ";" << ab.Size() << ";"
+           << chrono :: duration<double, milli>(t1 - t0).count() << endl;
+    }
+  }
+}
+
+
+/**
+ * @brief Compara la carga de un fichero grande de refranes sinteticos linea a
+ *        linea (operator>>) y ordenandolo antes en disco (OrdenaFichero y
+ *        BuildFromSorted)
+ * @param n : numero de lineas del fichero
+ * @param len : longitud del prefijo
+ */
+void EstudioMasivo ( int n, int len ) {
+
+  const string fichero = "estudio_carga.txt";
+  const string ordenado = "estudio_carga_ordenado.txt";
+
+  vector<string> refranes = Sinteticos(n);
+  {
+    ofstream fout ( fichero.c_str() );
+    for ( size_t i = 0 ; i < refranes.size() ; i++ )
+      fout << refranes[i] << '\n';
+  }
+  refranes = vector<string>();
+
+  cout << "Metodo;#Refranes;#Nodos;Carga(ms)" << endl;
+
+  Refranes uno(len);
+  chrono :: steady_clock :: time_point t0 = chrono :: steady_clock :: now();
+  {
+    ifstream fin ( fichero.c_str() );
+    fin >> uno;
+  }
+  chrono :: steady_clock :: time_point t1 = chrono :: steady_clock :: now();
+
+  cout << "Linea a linea;" << uno.size() << ";" << uno.Numero_Nodos() << ";"
+       << chrono :: duration<double, milli>(t1 - t0).count() << endl;
+  uno.clear();
+
+  // Con memoria para una decima parte de las lineas, para forzar la mezcla
+  Refranes masivo(len);
+  t0 = chrono :: steady_clock :: now();
+  Refranes :: OrdenaFichero(fichero, ordenado, n / 10 + 1);
+  t1 = chrono :: steady_clock :: now();
+  {
+    ifstream fin ( ordenado.c_str() );
+    masivo.BuildFromSorted(fin);
+  }
+  chrono :: steady_clock :: time_point t2 = chrono :: steady_clock :: now();
+
+  cout << "Ordenacion externa;" << masivo.size() << ";" << masivo.Numero_Nodos() << ";"
+       << chrono :: duration<double, milli>(t1 - t0).count() << endl;
+  cout << "BuildFromSorted;" << masivo.size() << ";" << masivo.Numero_Nodos() << ";"
+       << chrono :: duration<double, milli>(t2 - t1).count() << endl;
+
+  remove(fichero.c_str());
+  remove(ordenado.c_str());
+}
+
+
+
+/**
+ * @brief Escribe una fila del estudio de lectura
+ */
+void FilaLectura ( const string &lector, size_t lineas, size_t bytes, double ms, size_t nreservas ) {
+
+  double mb = bytes / (1024.0 * 1024.0);
+  cout << lector << ";" << lineas << ";" << mb << ";" << ms << ";"
+       << mb / (ms / 1000.0) << ";" << nreservas << endl;
+}
+
+
+/**
+ * @brief Compara la lectura de un fichero grande con getline, como hacia
+ *        operator>>, y con LectorLineas, y la carga completa con operator>>
+ * @param n : numero de lineas del fichero
+ * @param len : longitud del prefijo
+ * @note Una de cada diez lineas acaba en "\r" y otra en espacios, y hay
+ *       lineas en blanco, como en los ficheros copiados de Windows
+ */
+void EstudioLectura ( int n, int len ) {
+
+  const string fichero = "estudio_lectura.txt";
+
+  vector<string> refranes = Sinteticos(n);
+  size_t bytes = 0;
+  {
+    ofstream fout ( fichero.c_str(), ios :: binary );
+    for ( size_t i = 0 ; i < refranes.size() ; i++ ) {
+      fout << refranes[i] << ( i % 10 == 0 ? "\r\n" : i % 10 == 1 ? "  \n" : i % 10 == 2 ? "\n\n" : "\n" );
+      bytes += refranes[i].size() + ( i % 10 < 3 ? 3 : 1 );
+    }
+  }
+  refranes = vector<string>();
+
+  cout << "Lector;#Lineas;MB;Tiempo(ms);MB/s;Reservas" << endl;
+
+  // Como el operator>> original: una cadena nueva por linea
+  size_t lineas = 0;
+  size_t reservas_ini = reservas;
+  chrono :: steady_clock :: time_point t0 = chrono :: steady_clock :: now();
+  {
+    ifstream fin ( fichero.c_str() );
+    while ( !fin.eof() ) {
+      string linea;
+      getline(fin, linea);
+      while ( !linea.empty() && (linea[linea.size()-1] == '\r' || linea[linea.size()-1] == ' ') )
+        linea.pop_back();
+      if ( !linea.empty() )
+        lineas++;
+    }
+  }
+  chrono :: steady_clock :: time_point t1 = chrono :: steady_clock :: now();
+  FilaLectura("getline", lineas, bytes, chrono :: duration<double, milli>(t1 - t0).count(), reservas - reservas_ini);
+
+  for ( int minusculas = 0 ; minusculas <= 1 ; minusculas++ ) {
+    lineas = 0;
+    reservas_ini = reservas;
+    t0 = chrono :: steady_clock :: now();
+    {
+      ifstream fin ( fichero.c_str() );
+      LectorLineas lector(fin, minusculas);
+      while ( lector.Siguiente() )
+        lineas++;
+    }
+    t1 = chrono :: steady_clock :: now();
+    FilaLectura(minusculas ? "LectorLineas(minusculas)" : "LectorLineas", lineas, bytes,
+                chrono :: duration<double, milli>(t1 - t0).count(), reservas - reservas_ini);
+  }
+
+  Refranes refs(len);
+  reservas_ini = reservas;
+  t0 = chrono :: steady_clock :: now();
+  {
+    ifstream fin ( fichero.c_str() );
+    fin >> refs;
+  }
+  t1 = chrono :: steady_clock :: now();
+  FilaLectura("operator>>", refs.size(), bytes, chrono :: duration<double, milli>(t1 - t0).count(), reservas - reservas_ini);
+
+  remove(fichero.c_str());
+}
+
+
+
+int main ( int argc, char** argv ) {
+
+  if ( argc >= 2 && string(argv[1]) == "-l" ) {
+    srand(1);
+    EstudioLectura(argc >= 3 ? atoi(argv[2]) : 1000000, argc >= 4 ? atoi(argv[3]) : 3);
+    return 0;
+  }
+
+  if ( argc >= 2 && string(argv[1]) == "-m" ) {
+    srand(1);
+    EstudioMasivo(argc >= 3 ? atoi(argv[2]) : 1000000, argc >= 4 ? atoi(argv[3]) : 3);
+    return 0;
+  }
+
+  if ( argc >= 2 && string(argv[1]) == "-s" ) {
+    srand(1);
+    EstudioSinteticos(argc >= 3 ? atoi(argv[2]) : 100000, argc >= 4 ? atoi(argv[3]) : 3);
+    return 0;
+  }
+
+  if ( argc < 2 || argc > 4 ) {
+    cout << "\n Los parametros son : " << endl;
+    cout << " 1.- Dime el nombre del fichero los refranes" << endl;
+    cout << " 2.- [Opcional] Numero de veces que se repite el fichero (por defecto 10)" << endl;
+    cout << " 3.- [Opcional] Prefijo de los refranes (por defecto 3)" << endl;
+    cout << " Con -s [n] [prefijo] compara la carga de n refranes sinteticos (por defecto 100000)" << endl;
+    cout << " Con -m [n] [prefijo] compara la carga de un fichero de n refranes sinteticos" << endl;
+    cout << "    linea a linea y ordenado en disco (por defecto 1000000)" << endl;
+    cout << " Con -l [n] [prefijo] compara la lectura de un fichero de n refranes sinteticos" << endl;
+    cout << "    con getline y con LectorLineas (por defecto 1000000)" << endl << endl;
+    return 0;
+  }
+
+  ifstream fin ( argv[1] );
+
+  if (!fin) {
+    cout << "\n No puedo abrir el fichero " << argv[1] << endl;
+    return 0;
+  }
+
+  int factor = argc >= 3 ? atoi(argv[2]) : 10;
+  int len = argc == 4 ? atoi(argv[3]) : 3;
+
+  istringstream corpus ( Escalar(fin, factor) );
+  Refranes refs(len);
+
+  size_t reservas_ini = reservas;
+  chrono :: steady_clock :: time_point t0 = chrono :: steady_clock :: now();
+  corpus >> refs;
+  chrono :: steady_clock :: time_point t1 = chrono :: steady_clock :: now();
+
+  cout << "Factor;#Refranes;#Nodos;Carga(ms);Reservas" << endl;
+  cout << factor << ";"
+       << refs.size() << ";"
+       << refs.Numero_Nodos() << ";"
+       << chrono :: duration<double, milli>(t1 - t0).count() << ";"
+       << reservas - reservas_ini << endl;
+
+  return 0;
+}
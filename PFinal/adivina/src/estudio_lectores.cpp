@@ -0,0 +1,143 @@
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <vector>
+#include "refranes_compartidos.h"
+#include "LectorLineas.h"
+
+using namespace std;
+
+
+/**
+ * @file estudio_lectores.cpp
+ * @author Gregorio Vidoy Fajardo y Jesus Ruiz Castellano
+ * @date 26 de enero de 2017, 12:10
+ * @brief Fichero con el estudio de las consultas simultaneas de varios
+ *        hilos sobre un mismo conjunto de refranes (RefranesCompartidos)
+ */
+
+
+/**
+ * @brief Hace consultas sobre la version actual de los refranes: un refran
+ *        al azar (Aleatorio), si esta (Esta) y los que empiezan como el
+ *        (ConPrefijo)
+ * @param refs : refranes compartidos
+ * @param n : numero de consultas
+ * @param semilla : semilla del generador del hilo
+ * @param aciertos : al terminar, numero de refranes encontrados; sirve para
+ *        comprobar el resultado y para que no se descarten las consultas
+ * @note Cada consulta toma una instantanea nueva, como haria un servidor
+ */
+void Lector ( const RefranesCompartidos &refs, int n, unsigned semilla, long &aciertos ) {
+
+  mt19937 gen(semilla);
+  long encontrados = 0;
+
+  for ( int i = 0 ; i < n ; i++ ) {
+    shared_ptr<const Refranes> r = refs.Lector();
+    if ( r->size() == 0 )
+      continue;
+
+    Refranes :: const_iterator k = r->Aleatorio(gen);
+    const string &refran = *k;
+
+    if ( r->Esta(refran).first )
+      encontrados++;
+
+    Refranes :: Rango rango = r->ConPrefijo(refran.substr(0, 3), 10);
+    for ( Refranes :: Rango :: iterator it = rango.begin() ; it != rango.end() ; ++it )
+      encontrados += (*it).size() > 0;
+  }
+
+  aciertos = encontrados;
+}
+
+
+/**
+ * @brief Mide las consultas por segundo con un numero de hilos lectores
+ * @param refs : refranes compartidos
+ * @param hilos : numero de hilos lectores
+ * @param consultas : consultas de cada hilo
+ * @param escritor : si es true, otro hilo añade y borra un refran sin parar
+ *        mientras los lectores consultan
+ */
+void Medir ( RefranesCompartidos &refs, int hilos, int consultas, bool escritor ) {
+
+  vector<thread> lectores;
+  vector<long> aciertos(hilos, 0);
+  atomic<bool> terminado(false);
+  int versiones = 0;
+
+  chrono :: steady_clock :: time_point t0 = chrono :: steady_clock :: now();
+
+  thread modificador;
+  if ( escritor )
+    modificador = thread([&refs, &terminado, &versiones] () {
+      while ( !terminado ) {
+        refs.Modificar([] ( Refranes &r ) { r.Insertar("zzz refran de prueba"); });
+        refs.Modificar([] ( Refranes &r ) { r.BorrarRefran("zzz refran de prueba"); });
+        versiones += 2;
+      }
+    });
+
+  for ( int h = 0 ; h < hilos ; h++ )
+    lectores.push_back(thread(Lector, cref(refs), consultas, h + 1, ref(aciertos[h])));
+  for ( int h = 0 ; h < hilos ; h++ )
+    lectores[h].join();
+
+  chrono :: steady_clock :: time_point t1 = chrono :: steady_clock :: now();
+
+  terminado = true;
+  if ( escritor )
+    modificador.join();
+
+  long total = 0;
+  for ( int h = 0 ; h < hilos ; h++ )
+    total += aciertos[h];
+
+  double ms = chrono :: duration<double, milli>(t1 - t0).count();
+  cout << hilos << ";" << (escritor ? "si" : "no") << ";" << versiones << ";"
+       << (long)hilos * consultas << ";" << total << ";" << ms << ";"
+       << hilos * consultas / (ms / 1000.0) << endl;
+}
+
+
+
+int main ( int argc, char** argv ) {
+
+  if ( argc < 2 || argc > 4 ) {
+    cout << "\n Los parametros son : " << endl;
+    cout << " 1.- Dime el nombre del fichero los refranes" << endl;
+    cout << " 2.- [Opcional] Consultas de cada hilo (por defecto 100000)" << endl;
+    cout << " 3.- [Opcional] Numero maximo de hilos lectores (por defecto 8)" << endl << endl;
+    return 0;
+  }
+
+  ifstream fin ( argv[1] );
+
+  if (!fin) {
+    cout << "\n No puedo abrir el fichero " << argv[1] << endl;
+    return 0;
+  }
+
+  int consultas = argc >= 3 ? atoi(argv[2]) : 100000;
+  int maximo = argc == 4 ? atoi(argv[3]) : 8;
+
+  Refranes inicial;
+  LeeRefranes(fin, inicial);
+  {
+    RefranesCompartidos refs(inicial);
+
+    cout << "Hilos;Escritor;Versiones;Consultas;Encontrados;Tiempo(ms);Consultas/s" << endl;
+    for ( int escritor = 0 ; escritor <= 1 ; escritor++ )
+      for ( int hilos = 1 ; hilos <= maximo ; hilos *= 2 )
+        Medir(refs, hilos, consultas, escritor);
+  }
+
+  return 0;
+}
@@ -1,5 +1,7 @@
 #include <cstdlib>
 #include "refranes.h"
+#include "refranes_radix.h"
+#include "LectorLineas.h"
 
 using namespace std;
 
@@ -29,19 +31,32 @@ void cabeceraTabla ( ostream &os ) {
      //# Nodos    
      << "#Nodos " << ";"
      //%Red/#Nodos    
-     << "%Red/#Nodos" << endl;
+     << "%Red/#Nodos" << ";"
+     //Car.Colas
+     << "Car.Colas" << ";"
+     //%Red.Colas
+     << "%Red.Colas" << ";"
+     //Bytes por categoria (ver UsoMemoria)
+     << "Mem.Nodos" << ";" << "Mem.EnLinea" << ";" << "Mem.Heap" << ";"
+     << "Mem.Aux" << ";" << "Mem.Total" << ";"
+     //Arbol
+     << "Arbol" << endl;
 }
 
 
 /**
  * @brief Metodo para imprimir una fila de la tabla 
- * @param ref : Refranes de los que vamos a obtener los datos
+ * @param ref : Refranes (o RefranesRadix) de los que vamos a obtener los datos
+ * @param arbol : nombre de la representacion, para la ultima columna
  * @param os : Variable de flujo de escritura de los datos
  */
-void sacarDatosRefranes ( Refranes &ref, ostream &os ) {
+template <class R>
+void sacarDatosRefranes ( R &ref, const string &arbol, ostream &os ) {
    
  	// formula para obtener el porcentaje de reduccion
   double red = 100.0 - ( (ref.Caracteres_Almacenados()*100.0) / ref.Caracteres_Refranes() );
+  int colas = ref.Caracteres_Colas();
+  UsoMemoria mem = ref.MemoryUsage();
      //Prefijo
   os << ref.getLen_prefijo() << ";"
      //Car.Total
@@ -53,19 +68,33 @@ void sacarDatosRefranes ( Refranes &ref, ostream &os ) {
      //# Nodos    
      << ref.Numero_Nodos() << ";"
      //%Red/#Nodos    
-     << red/ref.Numero_Nodos() << endl;         
+     << red/ref.Numero_Nodos() << ";"
+     //Car.Colas
+     << colas << ";"
+     //%Red.Colas
+     << 100.0 - ( (colas*100.0) / ref.Caracteres_Refranes() ) << ";"
+     //Bytes por categoria
+     << mem.nodos << ";" << mem.en_linea << ";" << mem.heap << ";"
+     << mem.auxiliares << ";" << mem.Total() << ";"
+     //Arbol
+     << arbol << endl;
 }
 
 
 
 int main (int argc, char** argv) {
     
-  if ( argc != 3 ) {
+  if ( argc != 3 && !(argc == 4 && string(argv[3]) == "-n") ) {
     cout << "\n Los parametros son : " << endl;
     cout << " 1.- Dime el nombre del fichero los refranes" << endl;
-    cout << " 2.- Dime el nombre del fichero CSV de salida {nombreArchivo.csv}" << endl << endl;
+    cout << " 2.- Dime el nombre del fichero CSV de salida {nombreArchivo.csv}" << endl;
+    cout << " 3.- Opcional, -n para pasar los refranes a minuscula y sin acentos" << endl << endl;
     return 0;
   }
+
+  // Normalizados, los refranes que solo se distinguen por un acento o una
+  // mayuscula comparten rama
+  bool normalizar = argc == 4;
       
   // Creamos el fichero csv en el que vamos a sacar los datos
   ofstream salida ( argv[2] );
@@ -87,8 +116,27 @@ int main (int argc, char** argv) {
     }
 
     Refranes refs(i);
-    fin >> refs;
-    sacarDatosRefranes (refs, salida);  
+    LeeRefranes(fin, refs, normalizar, normalizar);
+    sacarDatosRefranes (refs, "Trie", salida);  
+  }
+
+  // Los mismos prefijos como maximo, dividiendo cada rama solo si compensa
+  for ( int i = 2 ; i <= 14 ; i++ ) {
+    ifstream fin ( argv[1] ); 
+
+    Refranes refs(i);
+    LeeRefranes(fin, refs, normalizar, normalizar);
+    refs.Optimiza();
+    sacarDatosRefranes (refs, "Optimo", salida);
+  }
+
+  // Los mismos prefijos con las cadenas de un solo hijo compactadas
+  for ( int i = 2 ; i <= 14 ; i++ ) {
+    ifstream fin ( argv[1] ); 
+
+    RefranesRadix refs(i);
+    LeeRefranes(fin, refs, normalizar, normalizar);
+    sacarDatosRefranes (refs, "Radix", salida);
   }
 
 	return 0;
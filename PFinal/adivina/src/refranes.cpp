@@ -1,5 +1,16 @@
 #include "refranes.h"
+#include "ArbolMapeado.h"
+#include "AlmacenColas.h"
+#include "LectorLineas.h"
+#include "Utf8.h"
 #include <vector>
+#include <cassert>
+#include <utility>
+#include <algorithm>
+#include <queue>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
 
 /** 
  * @file refranes.cpp 
@@ -11,6 +22,126 @@
 
 
 
+//-------------------------------------------------//
+//------------- PREFIJO DE LOS ITERADORES ---------//
+//-------------------------------------------------//
+
+/**
+ * @brief Reconstruye el prefijo de un iterador situado en cualquier nodo
+ * @param it : iterador en preorden del arbol de refranes
+ * @param prefijo : etiquetas de los antecesores del nodo, sin la raiz
+ * @param marca : marca[l+1] es la longitud de prefijo para un nodo de nivel l
+ * @param cad : refran completo del nodo, prefijo mas su etiqueta
+ * @note Sube una vez por padre: O(profundidad). Solo se usa al situar un
+ *       iterador en un nodo concreto, no al avanzar
+ */
+template <class It>
+static void Situar ( const It &it, string &prefijo, vector<size_t> &marca, string &cad ) {
+
+    prefijo.clear();
+    marca.assign(1, 0);
+    cad.clear();
+
+    if ( it.GetNodo() == 0 )
+        return;
+
+    vector<Refranes :: Arbol :: Nodo> antecesores;
+    for ( Refranes :: Arbol :: Nodo n = it.GetNodo()->padre ; n != 0 ; n = n->padre )
+        antecesores.push_back(n);
+
+    for ( int i = (int)antecesores.size() - 1 ; i >= 0 ; i-- ) {
+        prefijo += antecesores[i]->etiqueta;
+        marca.push_back(prefijo.size());
+    }
+
+    cad.assign(prefijo).append(it.GetNodo()->etiqueta);
+}
+
+
+/**
+ * @brief Avanza un iterador hasta la siguiente hoja, manteniendo su prefijo
+ * @param it : iterador en preorden del arbol de refranes
+ * @param prefijo : etiquetas de los antecesores del nodo, sin la raiz
+ * @param marca : marca[l+1] es la longitud de prefijo para un nodo de nivel l
+ * @param cad : refran completo de la hoja a la que se llega
+ * @note Al bajar se añade la etiqueta del padre y al subir o pasar a un
+ *       hermano se recorta prefijo a la marca de su nivel, sin reservar
+ *       memoria una vez que prefijo alcanza su longitud maxima. El refran
+ *       se compone aqui y no al consultarlo, de forma que operator* es const
+ *       y un iterador se puede leer desde varios hilos
+ */
+template <class It>
+static void Avanzar ( It &it, string &prefijo, vector<size_t> &marca, string &cad ) {
+
+    do {
+        int nivel = it.getLevel();
+        const string &etiqueta = *it;
+        ++it;
+
+        if ( it.GetNodo() == 0 ) {
+            prefijo.clear();
+            marca.assign(1, 0);
+            cad.clear();
+            return;
+        }
+
+        if ( it.getLevel() > nivel ) { // hemos bajado al primer hijo
+            prefijo += etiqueta;
+            marca.push_back(prefijo.size());
+        }
+        else {
+            marca.resize(it.getLevel() + 2);
+            prefijo.resize(marca.back());
+        }
+    } while ( !it.Hoja() );
+
+    cad.assign(prefijo).append(it.GetNodo()->etiqueta);
+}
+
+
+/**
+ * @brief Indica si una cadena tiene una letra dada en una posicion
+ * @param cad : cadena en UTF-8
+ * @param pos : byte donde empieza la letra de cad, pos < cad.size()
+ * @param letra : letra completa, con sus marcas diacriticas
+ * @note Compara la letra entera: "e" no coincide con el principio de "e\u0301"
+ */
+static bool MismaLetra ( const string &cad, size_t pos, const string &letra ) {
+    return Utf8 :: LongitudLetra(cad, pos) == letra.size() && cad.compare(pos, letra.size(), letra) == 0;
+}
+
+
+/**
+ * @brief Orden de las cadenas comparando letra a letra, como las etiquetas
+ *        de los nodos de letra. Los refranes deben estar en este orden para
+ *        que Construye encuentre seguidos los que comparten cada letra
+ * @note Coincide con el orden de los bytes salvo con marcas diacriticas
+ *       sueltas: "e" va antes que "e\u0301", pero "e€" va despues
+ */
+static bool MenorPorLetras ( const string &a, const string &b ) {
+
+    size_t pos = 0;
+    while ( pos < a.size() && pos < b.size() ) {
+        size_t la = Utf8 :: LongitudLetra(a, pos), lb = Utf8 :: LongitudLetra(b, pos);
+        int c = a.compare(pos, la, b, pos, lb);
+        if ( c != 0 )
+            return c < 0;
+        pos += la;
+    }
+
+    return a.size() < b.size();
+}
+
+
+/**
+ * @brief Orden de los bytes de dos cadenas, el de las hojas de un cubo
+ */
+static bool MenorPorBytes ( const string *a, const string *b ) {
+    return *a < *b;
+}
+
+
+
 //-------------------------------------------------//
 //--------------FUNCIONES PUBLICAS-----------------//
 //-------------------------------------------------//
@@ -20,6 +151,10 @@ Refranes :: Refranes () {
     len_prefijo = 3;
     n_ref = 0;
     caracteres_totales = 0;
+    umbral = 0;
+    congelado = false;
+    indexado = false;
+    indice_al_dia = false;
 }
 
 
@@ -28,6 +163,22 @@ Refranes :: Refranes ( int lpre ) {
     len_prefijo = lpre;
     n_ref = 0;
     caracteres_totales = 0;
+    umbral = 0;
+    congelado = false;
+    indexado = false;
+    indice_al_dia = false;
+}
+
+
+Refranes :: Refranes ( int lpre, int u ) {
+    ab.AsignaRaiz(""); 
+    len_prefijo = lpre;
+    n_ref = 0;
+    caracteres_totales = 0;
+    umbral = u;
+    congelado = false;
+    indexado = false;
+    indice_al_dia = false;
 }
 
 
@@ -38,165 +189,277 @@ int Refranes :: size () const {
 
 void Refranes :: Insertar ( const string &refran ) {
     
-    ArbolGeneral<string> :: iter_preorden itAPUNTA = ab.begin();
-    ArbolGeneral<string> :: iter_preorden itUltimoEncontrado = ab.begin();
-    bool bandera = false;
-
-    if ( ab.Size() == 1 ) { // Primer caso, arbol vacio
-        for ( int i = 0 ; i < len_prefijo ; i++ ) {
-            string refranAUX;
-            refranAUX.push_back(refran[i]);
-            ArbolGeneral<string> aux(refranAUX);
-            ab.Insertar_hijoMasIzquierda(itAPUNTA.GetNodo(),aux);
-            ++itAPUNTA;
-        }
-
-        string resto = refran.substr(len_prefijo,refran.size()-1);
-        ArbolGeneral<string> aux2(resto);
-        ab.Insertar_hijoMasIzquierda(itAPUNTA.GetNodo(),aux2);
-        
-        n_ref++;    
-    }
-
-    else if ( !Esta(refran).first ){ // arbol con algo
-
-        bandera = true;
-
-        for ( int i = 0 ; i < len_prefijo ; i++ ) {
-            bool encontrado = false; // bandera para salir del while
-            string refranAUX;
-            refranAUX.push_back(refran[i]);
-
-            ArbolGeneral<string> :: iter_preorden itRECORRE = ab.begin();
-            
-            //Buscamos si esta
-            while ( itRECORRE != ab.end() && !encontrado ) {
-                //Si es nivel 0 y no esta no compruebo padres
-                if ( (*itRECORRE) == refranAUX && itRECORRE.getLevel() == i && i == 0  ){
-                    encontrado = true;
-                    itUltimoEncontrado = itRECORRE;
-                    itAPUNTA = itUltimoEncontrado; 
-                }
-                //Si no es el nivel 0 compruebo todos los padres no justo el antetior sino todos hasta el nivel 0
-                else if( (*itRECORRE) == refranAUX && itRECORRE.getLevel() == i && i != 0  ){
-                    string letrasAnt;
-                    letrasAnt = refran.substr(0,i);
-                    string letrasPadre;
-                    
-                    //Cojo las letras de los padres
-                    ArbolGeneral<string> :: Nodo Naux = itRECORRE.GetNodo();
-
-                    while ( Naux->padre != 0 ) {
-                        string auxiliar = Naux->padre->etiqueta;
-                        letrasPadre.insert(0, auxiliar);
-                        Naux = Naux->padre;
-                    }
-                    if( letrasPadre == letrasAnt ){
-                        encontrado = true;
-                        itUltimoEncontrado = itRECORRE;
-                        itAPUNTA = itUltimoEncontrado; 
-                    }
-                }
-
-                ++itRECORRE;
-            }
-            
-            //Si no lo encuentra lo inserto apartir del ultimo encontrado
-            if ( !encontrado ) {
-                ArbolGeneral<string> aux(refranAUX);
-                ab.Insertar_hijoMasIzquierda(itUltimoEncontrado.GetNodo(),aux);
-                ++itUltimoEncontrado;
-                itAPUNTA = itUltimoEncontrado; 
-            }
-        }
-        //Pego lo que me quede despues del prefijo
-        if ( bandera == true ) {
-            string resto = refran.substr(len_prefijo,refran.size()-1);
-            ArbolGeneral<string> aux2(resto);
-            ab.Insertar_hijoMasIzquierda(itAPUNTA.GetNodo(),aux2);
-        }
+    // Sin letras suficientes para el prefijo no hay donde colgar el refran
+    // (p.ej. la linea vacia del final de un fichero)
+    if ( Utf8 :: Letras(refran, len_prefijo) < len_prefijo )
+        return;
+
+    if ( ab.Empty() )
+        ab.AsignaRaiz("");
+
+    int encontrados;
+    size_t pos;
+    Arbol :: Nodo ultimo = BuscaPrefijo(refran, encontrados, pos);
+    Arbol :: Nodo anterior;
+
+    if ( Cubo(ultimo) ) { // el refran cuelga de aqui con el resto de sus letras
+        string resto = refran.substr(pos);
+        if ( Hijo(ultimo, resto, anterior) != 0 )
+            return; // el refran ya esta
+
+        Descongelar();
+        if ( anterior == 0 )
+            ab.Insertar_hijoMasIzquierda(ultimo, ab.Rama(resto));
+        else
+            ab.Insertar_hermanoDerecha(anterior, ab.Rama(resto));
         n_ref++;
+        caracteres_totales += refran.size();
+
+        if ( encontrados < len_prefijo && ab.NumHojas(ultimo) > umbral )
+            Reparte(ultimo);
+        return;
     }
-}
 
+    Descongelar();
 
-void Refranes :: BorrarRefran (const string &refran) {
-    
-    iterator LocalizaRefran = begin(); 
-    iterator FIN = end();
-    bool SITUADO = false;
-    
-    // Localizamos el refran
-    while ( LocalizaRefran != FIN && !SITUADO ) {
-        
-        if ( (*LocalizaRefran) == refran )
-            SITUADO = true;
-        else
-            ++LocalizaRefran;
+    // Falta la letra siguiente: construimos la rama con las letras que faltan
+    // y el resto. Con umbral, la nueva rama es un cubo de un solo refran
+    int fondo = umbral > 0 ? encontrados + 1 : len_prefijo;
+    vector<size_t> inicio(1, pos); // byte donde empieza cada letra que falta
+    for ( int i = encontrados ; i < fondo ; i++ )
+        inicio.push_back(inicio.back() + Utf8 :: LongitudLetra(refran, inicio.back()));
+
+    Hijo(ultimo, refran.substr(pos, inicio[1] - pos), anterior);
+
+    Arbol rama = ab.Rama(refran.substr(inicio.back()));
+    for ( int i = fondo-1 ; i >= encontrados ; i-- ) {
+        size_t k = i - encontrados;
+        Arbol letra = ab.Rama(refran.substr(inicio[k], inicio[k+1] - inicio[k]));
+        letra.Insertar_hijoMasIzquierda(letra.Raiz(), std::move(rama));
+        rama = std::move(letra);
     }
-    // Al salir, LocalizaRefran apunta a la hoja donde termina refran. Empezamos a subir
 
-    if ( SITUADO ) { 
-    
-        ArbolGeneral<string> :: Nodo actual = LocalizaRefran.it.GetNodo();
-        ArbolGeneral<string> AlaHoguera; // aqui se almacena la morralla
-        bool FIN = false;
-                    
-        while ( actual->padre != 0 && !FIN ) {
-            
-            string MiFinEtiqueta = actual->etiqueta;                            
-            actual = actual->padre; // me posiciono en mi padre
-            
-            if ( actual->izqda->etiqueta == MiFinEtiqueta ) { // soy yo el hijo izquierda
-                ab.Podar_hijoMasIzquierda(actual, AlaHoguera);
-
-                if ( actual->izqda != 0 ) { // hemos terminado, lo que queda forma parte de otro refran
-                    FIN = true;
-                }
-            } 
-            else { // soy alguno de los hermanos derecha, tengo que encontrarme
-                
-                ArbolGeneral<string> :: Nodo hijoDerecho = actual->izqda; // es el "begin" del while
-                bool finDERECHA = false;
-                
-                while ( !finDERECHA ) {
-                                        
-                    if ( hijoDerecho->drcha->etiqueta == MiFinEtiqueta ) {
-                        ab.Podar_hermanoDerecha(hijoDerecho, AlaHoguera);
-                        finDERECHA = true;
-                    }
-
-                    hijoDerecho = hijoDerecho->drcha;
-                }
-                
-                FIN = true;
-            }
+    // y la pegamos en su sitio entre los hijos del ultimo nodo encontrado
+    if ( anterior == 0 )
+        ab.Insertar_hijoMasIzquierda(ultimo, std::move(rama));
+    else
+        ab.Insertar_hermanoDerecha(anterior, std::move(rama));
+
+    n_ref++;
+    caracteres_totales += refran.size();
+}
+
+
+void Refranes :: BorrarRefran ( const string &refran ) {
+
+    // Basta la hoja: no hace falta un iterador con el prefijo reconstruido
+    Arbol :: Nodo actual = BuscaHoja(refran);
+    if ( actual == 0 )
+        return;
+
+    Descongelar();
+
+    // Subimos desde la hoja quitando cada nodo que se queda sin hijos. Cada
+    // nodo se localiza entre sus hermanos por su direccion, no por su etiqueta
+    Arbol AlaHoguera; // sus nodos se reciclan en ab para las siguientes inserciones
+
+    do {
+        Arbol :: Nodo padre = ab.Padre(actual);
+        Arbol :: Nodo hermano = ab.HijoMasIzquierda(padre);
+
+        if ( hermano == actual )
+            ab.Podar_hijoMasIzquierda(padre, AlaHoguera);
+        else {
+            while ( ab.HermanoDerecha(hermano) != actual )
+                hermano = ab.HermanoDerecha(hermano);
+            ab.Podar_hermanoDerecha(hermano, AlaHoguera);
         }
-        n_ref--;
-    }
+        ab.Reciclar(AlaHoguera);
+
+        actual = padre;
+    } while ( actual != ab.Raiz() && ab.HijoMasIzquierda(actual) == 0 );
+
+    n_ref--;
+    caracteres_totales -= refran.size();
+}
+
+
+int Refranes :: BorrarRefranes ( const vector<string> &refranes ) {
+
+    int antes = n_ref;
+
+    for ( size_t i = 0 ; i < refranes.size() ; i++ )
+        BorrarRefran(refranes[i]);
+
+    return antes - n_ref;
 }
 
 
 pair<bool, Refranes :: iterator> Refranes :: Esta (const string &refran) {
     
-    size_t sizeT = -1;
-    bool bandera = false;
-    iterator it = end();
-    pair<bool, iterator> aux(bandera,it);
+    pair<bool, iterator> aux(false, end());
+    Arbol :: Nodo hoja = BuscaHoja(refran);
+
+    if ( hoja != 0 ) {
+        aux.first = true;
+        aux.second.it = ab.Posicion(hoja);
+        Situar(aux.second.it, aux.second.prefijo, aux.second.marca, aux.second.cad);
+    }
+
+    return aux; 
+}
+
+
+pair<bool, Refranes :: const_iterator> Refranes :: Esta (const string &refran) const {
     
+    pair<bool, const_iterator> aux(false, Cend());
+    Arbol :: Nodo hoja = BuscaHoja(refran);
 
-    for ( it = begin() ; it != end() && !bandera ; ++it )
-        if ( (*it).find(refran) != sizeT ) {
-            bandera = true;
-            aux.first = bandera;
-            aux.second = it;
-        }
+    if ( hoja != 0 ) {
+        aux.first = true;
+        aux.second.it = ab.Posicion(hoja);
+        Situar(aux.second.it, aux.second.prefijo, aux.second.marca, aux.second.cad);
+    }
 
     return aux; 
 }
 
 
+pair<bool, Refranes :: iterator> Refranes :: BuscaSubcadena (const string &patron) {
+    return BuscaSubcadena(patron, begin());
+}
+
+
+pair<bool, Refranes :: iterator> Refranes :: BuscaSubcadena (const string &patron, iterator desde) {
+
+    if ( indexado && desde != end() ) {
+        ActualizaIndice();
+        int k = indice.Primero(patron, Orden(desde.it.GetNodo()));
+        if ( k == -1 )
+            return pair<bool, iterator>(false, end());
+        return pair<bool, iterator>(true, RefranK(k));
+    }
+
+    for ( iterator it = desde ; it != end() ; ++it )
+        if ( (*it).find(patron) != string :: npos )
+            return pair<bool, iterator>(true, it);
+
+    return pair<bool, iterator>(false, end());
+}
+
+
+void Refranes :: IndexaSubcadenas ( bool activo ) {
+
+    indexado = activo;
+    if ( !indexado ) {
+        indice.clear();
+        indice_al_dia = false;
+    }
+}
+
+
+int Refranes :: CuentaSubcadena ( const string &patron ) {
+
+    ActualizaIndice();
+    return static_cast<const Refranes&>(*this).CuentaSubcadena(patron);
+}
+
+
+int Refranes :: CuentaSubcadena ( const string &patron ) const {
+
+    if ( indexado && indice_al_dia )
+        return indice.Cuenta(patron);
+
+    int n = 0;
+    if ( patron.empty() )
+        return n;
+
+    for ( const_iterator it = Cbegin() ; it != Cend() ; ++it )
+        for ( size_t p = (*it).find(patron) ; p != string :: npos ; p = (*it).find(patron, p+1) )
+            n++;
+
+    return n;
+}
+
+
+Refranes :: iterator Refranes :: RefranK ( int k ) {
+
+    assert ( 0 <= k && k < n_ref );
+    iterator it;
+    it.it = ab.Posicion(ab.HojaK(k));
+    Situar(it.it, it.prefijo, it.marca, it.cad);
+    return it;
+}
+
+
+Refranes :: const_iterator Refranes :: RefranK ( int k ) const {
+
+    assert ( 0 <= k && k < n_ref );
+    const_iterator it;
+    it.it = ab.Posicion(ab.HojaK(k));
+    Situar(it.it, it.prefijo, it.marca, it.cad);
+    return it;
+}
+
+
+Refranes :: Rango Refranes :: ConPrefijo ( const string &prefijo, int limite ) const {
+
+    Rango r;
+    r.primero = r.ultimo = Cend();
+    r.limite = limite;
+
+    if ( ab.Empty() || ab.HijoMasIzquierda(ab.Raiz()) == 0 || limite == 0 )
+        return r;
+
+    // Bajamos por las letras del prefijo mientras el arbol las tenga
+    Arbol :: Nodo actual = ab.Raiz();
+    Arbol :: Nodo anterior;
+    size_t d = 0;
+
+    while ( d < prefijo.size() && !Cubo(actual) ) {
+        size_t l = Utf8 :: LongitudLetra(prefijo, d);
+        actual = Hijo(actual, prefijo.substr(d, l), anterior);
+        if ( actual == 0 )
+            return r;
+        d += l;
+    }
+
+    Arbol :: Nodo primera, tras;
+
+    if ( d == prefijo.size() ) { // todas las hojas de actual
+        primera = PrimeraHoja(actual);
+        tras = HojaTras(actual);
+    }
+    else { // las hojas de actual que empiezan por el resto del prefijo
+        string resto = prefijo.substr(d);
+        primera = ab.HijoMasIzquierda(actual);
+        while ( primera != 0 && ab.Etiqueta(primera) < resto )
+            primera = ab.HermanoDerecha(primera);
+
+        if ( primera == 0 || ab.Etiqueta(primera).compare(0, resto.size(), resto) != 0 )
+            return r;
+
+        tras = primera;
+        for ( int n = 0 ; tras != 0 && ab.Etiqueta(tras).compare(0, resto.size(), resto) == 0
+                          && (limite < 0 || n < limite) ; n++ )
+            tras = ab.HermanoDerecha(tras);
+        if ( tras == 0 )
+            tras = HojaTras(actual);
+    }
+
+    r.primero.it = ab.Posicion(primera);
+    Situar(r.primero.it, r.primero.prefijo, r.primero.marca, r.primero.cad);
+    if ( tras != 0 ) {
+        r.ultimo.it = ab.Posicion(tras);
+        Situar(r.ultimo.it, r.ultimo.prefijo, r.ultimo.marca, r.ultimo.cad);
+    }
+
+    return r;
+}
+
+
 void Refranes :: clear () {
+    Descongelar();
     ab.Clear();
     len_prefijo = 0;
     n_ref = 0;
@@ -205,24 +468,206 @@ void Refranes :: clear () {
 
 
 
+void Refranes :: Umbral ( int u ) {
+    umbral = u;
+    Reconstruye(false);
+}
+
+
+void Refranes :: Optimiza () {
+    Reconstruye(true);
+}
+
+
+vector< pair<string, int> > Refranes :: Disposicion () const {
+
+    vector< pair<string, int> > cubos;
+
+    for ( Arbol :: const_iter_preorden it = ab.cbegin() ; it != ab.cend() ; ++it ) {
+        Arbol :: Nodo n = it.GetNodo();
+        Arbol :: Nodo hijo = ab.HijoMasIzquierda(n);
+        if ( hijo == 0 || ab.HijoMasIzquierda(hijo) != 0 )
+            continue;
+
+        string prefijo;
+        for ( Arbol :: Nodo p = n ; p != 0 ; p = p->padre )
+            prefijo.insert(0, p->etiqueta);
+        cubos.push_back(pair<string, int>(prefijo, ab.NumHojas(n)));
+    }
+
+    return cubos;
+}
+
+
+
+void Refranes :: BuildFromSorted ( istream &is ) {
+
+    Descongelar();
+    ab.AsignaRaiz("");
+    n_ref = 0;
+    caracteres_totales = 0;
+
+    // Se carga con todas las ramas a len_prefijo letras y al final se reparten
+    int u = umbral;
+    umbral = 0;
+
+    // camino[l] es el ultimo hijo de camino[l-1]; camino[0] la raiz y
+    // camino[len_prefijo+1] la ultima hoja. Es la rama del mayor refran leido
+    vector<Arbol :: Nodo> camino(1, ab.Raiz());
+    string maximo;
+    vector<size_t> inicio, inicio_maximo; // byte donde empieza cada letra del prefijo
+    LectorLineas lector(is);
+
+    while ( lector.Siguiente() ) {
+        const string &refran = lector.Linea();
+
+        inicio.assign(1, 0);
+        while ( (int)inicio.size() <= len_prefijo && inicio.back() < refran.size() )
+            inicio.push_back(inicio.back() + Utf8 :: LongitudLetra(refran, inicio.back()));
+        if ( (int)inicio.size() <= len_prefijo )
+            continue;
+
+        if ( n_ref > 0 && !(maximo < refran) ) { // fuera de orden o repetido
+            Insertar(refran);
+            continue;
+        }
+
+        // Niveles que comparte con el mayor refran leido: hasta ahi los bytes
+        // son los mismos, y por tanto tambien donde empieza cada letra
+        int comunes = 0;
+        if ( n_ref > 0 )
+            while ( comunes < len_prefijo && inicio[comunes+1] == inicio_maximo[comunes+1]
+                    && refran.compare(inicio[comunes], inicio[comunes+1] - inicio[comunes],
+                                      maximo, inicio[comunes], inicio[comunes+1] - inicio[comunes]) == 0 )
+                comunes++;
+
+        // Con marcas diacriticas sueltas el orden de las letras no siempre es
+        // el de los bytes ("e" va antes que "e\u0301" aunque "e€" > "e\u0301")
+        if ( n_ref > 0 && comunes < len_prefijo
+             && refran.compare(inicio[comunes], inicio[comunes+1] - inicio[comunes], maximo,
+                               inicio[comunes], inicio_maximo[comunes+1] - inicio[comunes]) < 0 ) {
+            Insertar(refran);
+            continue;
+        }
+
+        Arbol rama = ab.Rama(refran.substr(inicio[len_prefijo]));
+        for ( int i = len_prefijo-1 ; i >= comunes ; i-- ) {
+            Arbol letra = ab.Rama(refran.substr(inicio[i], inicio[i+1] - inicio[i]));
+            letra.Insertar_hijoMasIzquierda(letra.Raiz(), std::move(rama));
+            rama = std::move(letra);
+        }
+
+        // Es mayor que todo lo anterior: va a la derecha del camino
+        camino.resize(comunes + 2);
+        if ( n_ref == 0 ) {
+            ab.Insertar_hijoMasIzquierda(camino[0], std::move(rama));
+            camino[1] = ab.HijoMasIzquierda(camino[0]);
+        }
+        else {
+            ab.Insertar_hermanoDerecha(camino[comunes+1], std::move(rama));
+            camino[comunes+1] = ab.HermanoDerecha(camino[comunes+1]);
+        }
+        while ( ab.HijoMasIzquierda(camino.back()) != 0 )
+            camino.push_back(ab.HijoMasIzquierda(camino.back()));
+
+        caracteres_totales += refran.size();
+        maximo = refran;
+        inicio_maximo.swap(inicio);
+        n_ref++;
+    }
+
+    umbral = u;
+    if ( umbral > 0 )
+        Reconstruye(false);
+}
+
+
+bool Refranes :: OrdenaFichero ( const string &entrada, const string &salida, size_t lineas_memoria ) {
+
+    ifstream fin ( entrada.c_str() );
+    if ( !fin || lineas_memoria == 0 )
+        return false;
+    LectorLineas lector(fin);
+
+    // Los tramos se borran al salir, por cualquier return
+    struct Temporales {
+        vector<string> nombres;
+        ~Temporales() {
+            for ( size_t i = 0 ; i < nombres.size() ; i++ )
+                remove(nombres[i].c_str());
+        }
+    } tramos;
+
+    // 1. Tramos ordenados en ficheros temporales
+    vector<string> lineas;
+    string linea;
+    bool fin_fichero = false;
+
+    while ( !fin_fichero ) {
+        lineas.clear();
+        while ( lineas.size() < lineas_memoria && lector.Siguiente() )
+            lineas.push_back(lector.Linea());
+        fin_fichero = lineas.size() < lineas_memoria;
+        if ( lineas.empty() )
+            break;
+
+        // mkstemp crea un fichero que no existia, sin pisar ninguno
+        string nombre = salida + ".XXXXXX";
+        int fd = mkstemp(&nombre[0]);
+        if ( fd == -1 )
+            return false;
+        close(fd);
+        tramos.nombres.push_back(nombre);
+
+        sort(lineas.begin(), lineas.end());
+        ofstream ftramo ( nombre.c_str() );
+        for ( size_t i = 0 ; i < lineas.size() ; i++ )
+            ftramo << lineas[i] << '\n';
+        if ( !ftramo.flush() )
+            return false;
+    }
+    lineas = vector<string>();
+
+    // 2. Mezcla de todos los tramos, quitando repetidos
+    vector<ifstream> ftramos(tramos.nombres.size());
+    typedef pair<string, size_t> Cabeza; // linea y tramo del que sale
+    priority_queue< Cabeza, vector<Cabeza>, greater<Cabeza> > cabezas;
+
+    for ( size_t i = 0 ; i < ftramos.size() ; i++ ) {
+        ftramos[i].open(tramos.nombres[i].c_str());
+        if ( !ftramos[i] )
+            return false;
+        if ( getline(ftramos[i], linea) )
+            cabezas.push(Cabeza(linea, i));
+    }
+
+    ofstream fout ( salida.c_str() );
+    string anterior;
+    bool primera = true;
+
+    while ( !cabezas.empty() ) {
+        Cabeza c = cabezas.top();
+        cabezas.pop();
+        if ( primera || c.first != anterior ) {
+            fout << c.first << '\n';
+            anterior = c.first;
+            primera = false;
+        }
+        if ( getline(ftramos[c.second], linea) )
+            cabezas.push(Cabeza(linea, c.second));
+    }
+
+    return (bool)fout.flush();
+}
+
+
+
 //----------------------------------------------------//
 //-------------- FUNCIONES AMIGAS --------------------//
 //----------------------------------------------------//
 
 istream& operator>> (istream &is, Refranes &R) {
-
-    while (!is.eof()) {
-        string refran;
-        getline(is,refran);
-        
-        // Elimina posibles caracteres ' ' al final de los refranes
-        if (refran[refran.size()-1] == ' ')
-            refran.pop_back();
-        
-        R.Insertar(refran);
-    }
-
-    return is;
+    return LeeRefranes(is, R);
 }
 
 
@@ -239,19 +684,8 @@ ostream& operator<< (ostream &os, Refranes &R) {
     return os;
 }
 
-int Refranes :: Caracteres_Refranes () {
-    
-    int contador = 0;
-
-    iterator it = begin();
-    iterator itF = end(); 
-
-    while ( it != itF ) { 
-        contador += (*it).size(); 
-        ++it;
-    }
-    
-    return contador;
+int Refranes :: Caracteres_Refranes () const {
+    return caracteres_totales;
 }
 
 
@@ -259,49 +693,361 @@ int Refranes :: Caracteres_Almacenados () {
     
     int contador = 0;
 
-    ArbolGeneral<string> :: iter_preorden it = ab.begin();
-    ArbolGeneral<string> :: iter_preorden itF = ab.end(); 
+    if ( congelado ) {
+        for ( int i = 1 ; i < plano.Size() ; i++ ) // la raiz no se cuenta
+            contador += plano.Etiqueta(i).size();
+        return contador;
+    }
+
+    Arbol :: iter_preorden it = ab.begin();
+    Arbol :: iter_preorden itF = ab.end(); 
 
+    if ( it != itF )
+        ++it; // para no contar la raiz
     while ( it != itF ) { 
         contador += (*it).size(); 
         ++it;
     }
-    contador--; // para no contar la raiz
     
     return contador; 
 }
 
+int Refranes :: Caracteres_Colas () {
+
+    vector<string> etiquetas;
+    etiquetas.reserve(Numero_Nodos());
+
+    if ( congelado ) {
+        for ( int i = 1 ; i < plano.Size() ; i++ ) // la raiz no se cuenta
+            etiquetas.push_back(plano.Etiqueta(i));
+    }
+    else {
+        Arbol :: const_iter_preorden it = ab.cbegin();
+        if ( it != ab.cend() )
+            ++it; // para no contar la raiz
+        for ( ; it != ab.cend() ; ++it )
+            etiquetas.push_back(*it);
+    }
+
+    AlmacenColas colas;
+    colas.Construye(etiquetas);
+
+    return colas.Caracteres();
+}
+
+UsoMemoria Refranes :: MemoryUsage () const {
+
+    UsoMemoria u = ab.MemoryUsage();
+
+    if ( congelado )
+        u.auxiliares += plano.MemoryUsage().Total();
+    if ( indexado )
+        u.auxiliares += indice.Bytes();
+
+    return u;
+}
+
 int Refranes :: Numero_Nodos () const {
     return ab.Size(); 
 }
 
+void Refranes :: freeze () {
+    plano = ab.freeze();
+    congelado = true;
+}
 
+bool Refranes :: GuardaBinario ( const string &fichero, bool compartir_colas ) const {
 
-//-------------------------------------------------//
-//------------- FUNCIONES iterador ----------------//
-//-------------------------------------------------//       
+    ofstream fout ( fichero.c_str(), ios::binary );
+    return fout && ArbolMapeado :: Escribir(fout, ab.freeze(), compartir_colas);
+}
 
-string& Refranes :: iterator :: operator* () {
+bool Refranes :: CargaBinario ( const string &fichero ) {
 
-    string mi_cadena = "";
-    
-    if ( it.GetNodo() != 0 ) {
+    ArbolMapeado mapa;
+    if ( !mapa.Abrir(fichero) || mapa.Size() == 0 )
+        return false;
 
-        ArbolGeneral<string> :: Nodo aux = it.GetNodo();
-        
-        while ( aux->padre != 0 ) {
-            string auxiliar = aux->etiqueta;
-            mi_cadena.insert(0, auxiliar);
-            aux = aux->padre;
+    Descongelar();
+    mapa.Volcar(ab);
+    n_ref = 0;
+    caracteres_totales = 0;
+
+    // Las hojas son los restos de los refranes; las mas profundas estan en el
+    // nivel len_prefijo (las demas, si el arbol se guardo con umbral). Sin
+    // refranes el fichero no dice nada y se conserva el que habia
+    int profundidad = 0;
+    for ( int i = 1 ; i < mapa.Size() ; i++ )
+        if ( mapa.Hoja(i) ) {
+            n_ref++;
+            profundidad = max(profundidad, mapa.Nivel(i));
+        }
+    if ( n_ref > 0 )
+        len_prefijo = profundidad;
+
+    // Comprobamos que cada nodo es menor que su hermano derecha
+    bool ordenado = true;
+    for ( int i = 1 ; i < mapa.Size() && ordenado ; i++ ) {
+        int j = mapa.FinSubarbol(i);
+        if ( j < mapa.Size() && mapa.Padre(j) == mapa.Padre(i) && !(mapa.Etiqueta(i) < mapa.Etiqueta(j)) )
+            ordenado = false;
+    }
+
+    if ( !ordenado ) {
+        vector<string> refranes;
+        for ( iterator it = begin() ; it != end() ; ++it )
+            refranes.push_back(*it);
+        ab.AsignaRaiz("");
+        n_ref = 0;
+        for ( size_t i = 0 ; i < refranes.size() ; i++ )
+            Insertar(refranes[i]);
+    }
+    else
+        for ( iterator it = begin() ; it != end() ; ++it )
+            caracteres_totales += (*it).size();
+
+    return true;
+}
+
+Refranes :: Arbol :: Nodo Refranes :: BuscaPrefijo ( const string &refran, int &encontrados, size_t &pos ) const {
+
+    Arbol :: Nodo actual = ab.Raiz();
+    Arbol :: Nodo anterior;
+    encontrados = 0;
+    pos = 0;
+
+    // Bajamos un nivel por cada letra, mirando solo los hijos del nodo actual
+    while ( actual != 0 && encontrados < len_prefijo && pos < refran.size() ) {
+        size_t l = Utf8 :: LongitudLetra(refran, pos);
+        Arbol :: Nodo hijo = Hijo(actual, refran, pos, l, anterior);
+        if ( hijo == 0 || ab.HijoMasIzquierda(hijo) == 0 ) // las hojas no son letras
+            break;
+        actual = hijo;
+        encontrados++;
+        pos += l;
+    }
+
+    return actual;
+}
+
+Refranes :: Arbol :: Nodo Refranes :: BuscaHoja ( const string &refran ) const {
+
+    if ( ab.Empty() || Utf8 :: Letras(refran, len_prefijo) < len_prefijo )
+        return 0;
+
+    // Solo se mira la rama del prefijo y, dentro de ella, las hojas
+    int encontrados;
+    size_t pos;
+    Arbol :: Nodo prefijo = BuscaPrefijo(refran, encontrados, pos);
+
+    if ( !Cubo(prefijo) )
+        return 0;
+
+    Arbol :: Nodo anterior;
+    return Hijo(prefijo, refran, pos, refran.size() - pos, anterior);
+}
+
+
+Refranes :: Arbol :: Nodo Refranes :: Hijo ( Arbol :: Nodo padre, const string &etiqueta, Arbol :: Nodo &anterior ) const {
+    return Hijo(padre, etiqueta, 0, etiqueta.size(), anterior);
+}
+
+Refranes :: Arbol :: Nodo Refranes :: Hijo ( Arbol :: Nodo padre, const string &cad, size_t pos, size_t n, Arbol :: Nodo &anterior ) const {
+
+    anterior = 0;
+    Arbol :: Nodo hijo = ab.HijoMasIzquierda(padre);
+    int cmp = 1;
+
+    // Los hijos estan ordenados: paramos en el primero que no es menor
+    while ( hijo != 0 && (cmp = ab.Etiqueta(hijo).compare(0, string :: npos, cad, pos, n)) < 0 ) {
+        anterior = hijo;
+        hijo = ab.HermanoDerecha(hijo);
+    }
+
+    return ( hijo != 0 && cmp == 0 ) ? hijo : 0;
+}
+
+Refranes :: Arbol :: Nodo Refranes :: PrimeraHoja ( Arbol :: Nodo n ) const {
+
+    while ( ab.HijoMasIzquierda(n) != 0 )
+        n = ab.HijoMasIzquierda(n);
+
+    return n;
+}
+
+Refranes :: Arbol :: Nodo Refranes :: HojaTras ( Arbol :: Nodo n ) const {
+
+    while ( n != ab.Raiz() && ab.HermanoDerecha(n) == 0 )
+        n = ab.Padre(n);
+
+    return n == ab.Raiz() ? 0 : PrimeraHoja(ab.HermanoDerecha(n));
+}
+
+bool Refranes :: Cubo ( Arbol :: Nodo n ) const {
+
+    Arbol :: Nodo hijo = ab.HijoMasIzquierda(n);
+
+    if ( hijo == 0 ) // solo la raiz de un arbol vacio
+        return umbral > 0 || ab.Profundidad(n) == len_prefijo;
+
+    return ab.HijoMasIzquierda(hijo) == 0;
+}
+
+void Refranes :: Reparte ( Arbol :: Nodo n ) {
+
+    vector<string> restos;
+    Arbol AlaHoguera;
+
+    while ( ab.HijoMasIzquierda(n) != 0 ) {
+        restos.push_back(std::move(ab.Etiqueta(ab.HijoMasIzquierda(n))));
+        ab.Podar_hijoMasIzquierda(n, AlaHoguera);
+        ab.Reciclar(AlaHoguera);
+    }
+
+    if ( !is_sorted(restos.begin(), restos.end(), MenorPorLetras) )
+        sort(restos.begin(), restos.end(), MenorPorLetras);
+    Construye(n, ab.Profundidad(n), 0, restos, 0, restos.size(), false);
+}
+
+void Refranes :: Construye ( Arbol :: Nodo n, int d, size_t pos, const vector<string> &refranes, size_t a, size_t b, bool optimo ) {
+
+    bool dividir = d < len_prefijo;
+    if ( dividir && optimo ) {
+        int cubo = 0;
+        for ( size_t i = a ; i < b ; i++ )
+            cubo += 1 + refranes[i].size() - pos;
+        dividir = Coste(d, pos, refranes, a, b) < cubo;
+    }
+    else if ( dividir )
+        dividir = (int)(b - a) > umbral;
+
+    Arbol :: Nodo anterior = 0;
+
+    // Las hojas de un cubo van en el orden de sus bytes, que con marcas
+    // diacriticas sueltas puede no ser el de sus letras
+    vector<const string*> hojas;
+    if ( !dividir ) {
+        for ( size_t i = a ; i < b ; i++ )
+            hojas.push_back(&refranes[i]);
+        if ( !is_sorted(hojas.begin(), hojas.end(), MenorPorBytes) )
+            sort(hojas.begin(), hojas.end(), MenorPorBytes);
+    }
+
+    for ( size_t i = a ; i < b ; ) {
+        size_t j = i + 1;
+        string etiqueta;
+
+        if ( dividir ) { // un hijo por letra, con todos los refranes que la comparten
+            etiqueta = refranes[i].substr(pos, Utf8 :: LongitudLetra(refranes[i], pos));
+            while ( j < b && MismaLetra(refranes[j], pos, etiqueta) )
+                j++;
+        }
+        else
+            etiqueta = hojas[i - a]->substr(pos);
+
+        if ( anterior == 0 ) {
+            ab.Insertar_hijoMasIzquierda(n, ab.Rama(etiqueta));
+            anterior = ab.HijoMasIzquierda(n);
+        }
+        else {
+            ab.Insertar_hermanoDerecha(anterior, ab.Rama(etiqueta));
+            anterior = ab.HermanoDerecha(anterior);
         }
 
-        cad = mi_cadena;
+        if ( dividir )
+            Construye(anterior, d+1, pos + etiqueta.size(), refranes, i, j, optimo);
+        i = j;
     }
+}
+
+int Refranes :: Coste ( int d, size_t pos, const vector<string> &refranes, size_t a, size_t b ) const {
+
+    // Como un cubo: una hoja por refran con el resto de sus letras
+    int cubo = 0;
+    for ( size_t i = a ; i < b ; i++ )
+        cubo += 1 + refranes[i].size() - pos;
+
+    if ( d == len_prefijo )
+        return cubo;
+
+    // Dividido: un nodo y una letra por cada letra siguiente, mas sus ramas
+    int division = 0;
+    for ( size_t i = a ; i < b && division < cubo ; ) {
+        size_t j = i + 1;
+        string letra = refranes[i].substr(pos, Utf8 :: LongitudLetra(refranes[i], pos));
+        while ( j < b && MismaLetra(refranes[j], pos, letra) )
+            j++;
+        division += 1 + letra.size() + Coste(d+1, pos + letra.size(), refranes, i, j);
+        i = j;
+    }
+
+    return min(cubo, division);
+}
+
+void Refranes :: Reconstruye ( bool optimo ) {
+
+    vector<string> refranes;
+    refranes.reserve(n_ref);
+    for ( iterator it = begin() ; it != end() ; ++it )
+        refranes.push_back(*it);
+
+    if ( !is_sorted(refranes.begin(), refranes.end(), MenorPorLetras) )
+        sort(refranes.begin(), refranes.end(), MenorPorLetras);
+
+    Descongelar();
+    ab.AsignaRaiz("");
+    Construye(ab.Raiz(), 0, 0, refranes, 0, refranes.size(), optimo);
+}
+
+void Refranes :: Descongelar () {
+    if ( congelado ) {
+        plano = ArbolPlano<string>();
+        congelado = false;
+    }
+    indice_al_dia = false;
+}
+
+void Refranes :: PreparaLectura () {
+    ActualizaIndice();
+}
+
+void Refranes :: ActualizaIndice () {
+
+    if ( !indexado || indice_al_dia )
+        return;
+
+    vector<string> refranes;
+    refranes.reserve(n_ref);
+    for ( iterator it = begin() ; it != end() ; ++it )
+        refranes.push_back(*it);
+
+    indice.Construye(refranes);
+    indice_al_dia = true;
+}
+
+int Refranes :: Orden ( Arbol :: Nodo hoja ) const {
+
+    int k = 0;
+
+    for ( Arbol :: Nodo n = hoja ; n != ab.Raiz() ; n = ab.Padre(n) )
+        for ( Arbol :: Nodo h = ab.HijoMasIzquierda(ab.Padre(n)) ; h != n ; h = ab.HermanoDerecha(h) )
+            k += ab.NumHojas(h);
+
+    return k;
+}
+
+
+
+//-------------------------------------------------//
+//------------- FUNCIONES iterador ----------------//
+//-------------------------------------------------//       
+
+const string & Refranes :: iterator :: operator* () const {
     return cad;
 }
 
 bool Refranes :: iterator :: operator== ( const iterator &i ) const {
-    return it == i.it && cad == i.cad;        
+    return it == i.it;        
 }
 
 bool Refranes :: iterator :: operator!= ( const iterator &i ) const {
@@ -310,14 +1056,8 @@ bool Refranes :: iterator :: operator!= ( const iterator &i ) const {
 
 Refranes :: iterator & Refranes :: iterator :: operator ++ () {
 
-    if ( it.GetNodo() != 0 ) {
-        
-        ++it;
-
-        if ( it.GetNodo() != 0 ) 
-            while ( !it.Hoja() ) 
-                ++it;      
-    }
+    if ( it.GetNodo() != 0 )
+        Avanzar(it, prefijo, marca, cad);
 
     return *this;
 }
@@ -328,21 +1068,23 @@ Refranes :: iterator & Refranes :: iterator :: operator ++ () {
 //------------- FUNCIONES const_iterator ----------//
 //-------------------------------------------------//   
 
-Refranes :: const_iterator :: const_iterator () {
+Refranes :: const_iterator :: const_iterator () : marca(1, 0) {
     cad = "";
 }
 
 Refranes :: const_iterator :: const_iterator (const iterator  &i) {
     it = i.it;
     cad = i.cad;
+    prefijo = i.prefijo;
+    marca = i.marca;
 }
 
-string & Refranes :: const_iterator :: operator *() {
+const string & Refranes :: const_iterator :: operator *() const {
     return cad;
 }
 
 bool Refranes :: const_iterator :: operator== (const const_iterator &i) const {
-    return it == i.it && cad == i.cad; 
+    return it == i.it; 
 }
 
 bool Refranes :: const_iterator :: operator!= ( const const_iterator &i ) const {
@@ -351,14 +1093,8 @@ bool Refranes :: const_iterator :: operator!= ( const const_iterator &i ) const
 
 Refranes :: const_iterator & Refranes :: const_iterator :: operator ++ () { 
     
-    if ( it.GetNodo() != 0 ) {
-        
-        ++it;
-
-        if ( it.GetNodo() != 0 ) 
-            while ( !it.Hoja() ) 
-                ++it;      
-    }
+    if ( it.GetNodo() != 0 )
+        Avanzar(it, prefijo, marca, cad);
 
     return *this;
 }
@@ -369,16 +1105,43 @@ Refranes :: const_iterator & Refranes :: const_iterator :: operator ++ () {
 //------------- BEGIN y END -----------------------//
 //-------------------------------------------------//
 
+Refranes :: Rango :: iterator & Refranes :: Rango :: iterator :: operator ++ () {
+
+    ++it;
+    if ( quedan > 0 && --quedan == 0 )
+        it = fin;
+
+    return *this;
+}
+
+
+Refranes :: Rango :: iterator Refranes :: Rango :: begin () const {
+    iterator i;
+    i.it = limite == 0 ? ultimo : primero;
+    i.fin = ultimo;
+    i.quedan = limite;
+    return i;
+}
+
+
+Refranes :: Rango :: iterator Refranes :: Rango :: end () const {
+    iterator i;
+    i.it = i.fin = ultimo;
+    i.quedan = 0;
+    return i;
+}
+
+
 Refranes :: iterator Refranes :: begin () {
 
     iterator itb;
-    ArbolGeneral<string> :: iter_preorden it;
-    it = ab.begin();
+    itb.it = ab.begin();
 
-    while ( !it.Hoja() ) 
-        ++it;
-    
-    itb.it = it;
+    // Sin refranes la raiz es hoja pero no es un refran
+    if ( ab.Empty() || ab.HijoMasIzquierda(ab.Raiz()) == 0 )
+        return end();
+
+    Avanzar(itb.it, itb.prefijo, itb.marca, itb.cad);
     return itb;
 }
 
@@ -392,13 +1155,12 @@ Refranes :: iterator Refranes :: end () {
 Refranes :: const_iterator Refranes :: Cbegin () const {
 
     const_iterator itb;
-    ArbolGeneral<string> :: const_iter_preorden it;
-    it = ab.cbegin();
+    itb.it = ab.cbegin();
 
-    while ( !it.Hoja() ) 
-        ++it;
-    
-    itb.it = it;
+    if ( ab.Empty() || ab.HijoMasIzquierda(ab.Raiz()) == 0 )
+        return Cend();
+
+    Avanzar(itb.it, itb.prefijo, itb.marca, itb.cad);
     return itb;
 }
 
@@ -406,4 +1168,4 @@ Refranes :: const_iterator Refranes :: Cend () const {
     const_iterator ite;
     ite.it = ab.cend();
     return ite;
-}
\ No newline at end of file
+}
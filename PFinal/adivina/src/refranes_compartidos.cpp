@@ -0,0 +1,59 @@
+#include "refranes_compartidos.h"
+
+/**
+ * @file refranes_compartidos.cpp
+ * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+ * @date 26/01/2017
+ * @brief Fichero implementacion del TDA RefranesCompartidos
+ */
+
+
+
+//-------------------------------------------------//
+//--------------FUNCIONES PRIVADAS-----------------//
+//-------------------------------------------------//
+
+void RefranesCompartidos :: Publica ( shared_ptr<const Refranes> nueva ) {
+
+    retirados.push_back(Lector());
+    atomic_store(&actual, nueva);
+    Recoge();
+}
+
+
+void RefranesCompartidos :: Recoge () {
+
+    // Con use_count() == 1 solo la tiene retirados, y ya no la puede tomar
+    // ningun lector porque no es la actual
+    size_t quedan = 0;
+    for ( size_t i = 0 ; i < retirados.size() ; i++ )
+        if ( retirados[i].use_count() > 1 )
+            retirados[quedan++] = retirados[i];
+    retirados.resize(quedan);
+}
+
+
+
+//-------------------------------------------------//
+//--------------FUNCIONES PUBLICAS-----------------//
+//-------------------------------------------------//
+
+RefranesCompartidos :: RefranesCompartidos ( const Refranes &inicial ) {
+
+    shared_ptr<Refranes> copia(new Refranes(inicial));
+    copia->PreparaLectura();
+    actual = copia;
+}
+
+
+shared_ptr<const Refranes> RefranesCompartidos :: Lector () const {
+    return atomic_load(&actual);
+}
+
+
+int RefranesCompartidos :: Retirados () {
+
+    lock_guard<mutex> bloqueo(escritura);
+    Recoge();
+    return retirados.size();
+}
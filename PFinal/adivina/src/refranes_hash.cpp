@@ -1,4 +1,5 @@
 #include "refranes_hash.h"
+#include "LectorLineas.h"
 #include <vector>
 
 /** 
@@ -22,13 +23,11 @@ void Refranes :: my_hash :: set_len (int l) {
 
 size_t Refranes :: my_hash :: operator() (const string & clave) const {
 
+    // Las len primeras letras, en base 28 (la letra mas significativa primero)
     size_t valor = 0;
-    int exp = 2;
     
-    for ( int i = 0 ; i < 3 ; i++ ) {
-        valor += clave[0] * (pow(28,exp));
-        exp--;
-    }
+    for ( unsigned int i = 0 ; i < len && i < clave.size() ; i++ )
+        valor = valor * 28 + (unsigned char)clave[i];
     
     return valor;
 }
@@ -46,18 +45,59 @@ Refranes :: Refranes () {
 }
 
 
+Refranes :: Refranes ( const Refranes &R ) : ab(R.ab) {
+
+    n_ref = R.n_ref;
+    caracteres_totales = R.caracteres_totales;
+    Indexa();
+}
+
+
+Refranes & Refranes :: operator= ( const Refranes &R ) {
+
+    if ( this != &R ) {
+        ab = R.ab;
+        n_ref = R.n_ref;
+        caracteres_totales = R.caracteres_totales;
+        Indexa();
+    }
+
+    return *this;
+}
+
+
 int Refranes :: size () const {
     return ab.size();
 }
 
 
 void Refranes :: Insertar ( const string &refran ) {
-    ab.insert(refran);
+
+    pair<unordered_set<string,my_hash> :: iterator, bool> r = ab.insert(refran);
+    if ( r.second ) {
+        indice[&*r.first] = posiciones.size();
+        posiciones.push_back(&*r.first);
+    }
 }
 
 
 void Refranes :: BorrarRefran ( const string &refran) {
-    ab.erase(refran);
+
+    unordered_set<string,my_hash> :: iterator it = ab.find(refran);
+    if ( it == ab.end() )
+        return;
+
+    // Su hueco en posiciones lo ocupa el ultimo
+    unordered_map<const string*, size_t> :: iterator donde = indice.find(&*it);
+    size_t i = donde->second;
+    indice.erase(donde);
+
+    posiciones[i] = posiciones.back();
+    posiciones.pop_back();
+    if ( i < posiciones.size() )
+        indice[posiciones[i]] = i;
+
+    ab.erase(it);
 }
 
 
@@ -84,6 +124,8 @@ pair<bool,Refranes ::iterator> Refranes :: Esta (const string &refran) {
 
 void Refranes :: clear () {
     ab.clear();
+    posiciones.clear();
+    indice.clear();
 }
 
 
@@ -93,18 +135,7 @@ void Refranes :: clear () {
 //----------------------------------------------------//
 
 istream& operator>> (istream &is, Refranes &R) {
-
-    while ( !is.eof() ) {
-        string refran;
-        getline(is,refran);
-
-        if (refran[refran.size()-1] == ' ') 
-            refran.pop_back();
-
-        R.Insertar(refran);
-    }
-
-    return is;
+    return LeeRefranes(is, R);
 }
 
 
@@ -121,6 +152,30 @@ ostream& operator<< (ostream &os, Refranes &R) {
 }
 
 
+UsoMemoria Refranes :: MemoryUsage () const {
+
+    UsoMemoria u;
+    u.cubetas = ab.bucket_count() * sizeof(void*);
+    u.nodos = ab.size() * ( sizeof(void*) + sizeof(size_t) );
+    u.en_linea = ab.size() * sizeof(string);
+    u.auxiliares = posiciones.capacity() * sizeof(const string*);
+
+    // Cubetas y nodos del indice: enlace y pareja, sin hash guardado, que
+    // para punteros es trivial
+    u.auxiliares += indice.bucket_count() * sizeof(void*);
+    u.auxiliares += indice.size() * ( sizeof(void*) + sizeof(pair<const string*, size_t>) );
+
+    for ( unordered_set<string,my_hash> :: const_iterator it = ab.begin() ; it != ab.end() ; ++it ) {
+        size_t fuera = MemoriaExterna(*it);
+        u.heap += fuera;
+        if ( fuera > 0 )
+            u.cadenas_heap++;
+    }
+
+    return u;
+}
+
+
 int Refranes :: Caracteres_Refranes () {
     
     int contador = 0;
@@ -138,6 +193,24 @@ int Refranes :: Caracteres_Refranes () {
 
 
 
+//---------------------------------------------------//
+//-------------- FUNCIONES PRIVADAS -----------------//
+//---------------------------------------------------//
+
+void Refranes :: Indexa () {
+
+    posiciones.clear();
+    posiciones.reserve(ab.size());
+    indice.clear();
+    indice.reserve(ab.size());
+    for ( unordered_set<string,my_hash> :: const_iterator it = ab.begin() ; it != ab.end() ; ++it ) {
+        indice[&*it] = posiciones.size();
+        posiciones.push_back(&*it);
+    }
+}
+
+
+
 //-------------------------------------------------//
 //------------- FUNCIONES iterador ----------------//
 //-------------------------------------------------//       
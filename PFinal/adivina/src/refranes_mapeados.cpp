@@ -0,0 +1,44 @@
+#include "refranes_mapeados.h"
+
+/**
+ * @file refranes_mapeados.cpp
+ * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+ * @date 26/01/2017
+ * @brief Fichero implementacion del TDA RefranesMapeados
+ */
+
+
+
+//-------------------------------------------------//
+//--------------FUNCIONES PUBLICAS-----------------//
+//-------------------------------------------------//
+
+bool RefranesMapeados :: Abrir ( const string &fichero ) {
+
+    hojas.clear();
+    if ( !mapa.Abrir(fichero) )
+        return false;
+
+    for ( int i = 1 ; i < mapa.Size() ; i++ )
+        if ( mapa.Hoja(i) )
+            hojas.push_back(i);
+
+    return true;
+}
+
+
+string RefranesMapeados :: Refran ( int k ) const {
+
+    // Primero se mide, para componerlo de una vez de la raiz a la hoja
+    int longitud = 0;
+    for ( int i = hojas[k] ; mapa.Padre(i) != -1 ; i = mapa.Padre(i) )
+        longitud += mapa.Longitud(i);
+
+    string refran(longitud, ' ');
+    for ( int i = hojas[k] ; mapa.Padre(i) != -1 ; i = mapa.Padre(i) ) {
+        longitud -= mapa.Longitud(i);
+        refran.replace(longitud, mapa.Longitud(i), mapa.Datos(i), mapa.Longitud(i));
+    }
+
+    return refran;
+}
@@ -0,0 +1,525 @@
+#include "refranes_radix.h"
+#include "LectorLineas.h"
+#include "AlmacenColas.h"
+#include "Utf8.h"
+#include <algorithm>
+#include <utility>
+
+/**
+ * @file refranes_radix.cpp
+ * @author Jesus Ruiz Castellano y Gregorio Vidoy Fajardo
+ * @date 19/01/2017
+ * @brief Fichero implementacion del TDA RefranesRadix
+ */
+
+
+
+//-------------------------------------------------//
+//--------------FUNCIONES PRIVADAS-----------------//
+//-------------------------------------------------//
+
+Tramo RefranesRadix :: Guarda ( const string &cad, size_t desde ) {
+
+    Tramo t;
+    t.inicio = almacen.size();
+    t.longitud = cad.size() - desde;
+    almacen.append(cad, desde, string :: npos);
+    return t;
+}
+
+
+void RefranesRadix :: Compacta () {
+
+    string nuevo;
+    nuevo.reserve(almacen.size() - muertos);
+
+    // En preorden cada nodo queda justo antes de su primer hijo, y al unirlos
+    // en BorrarRefran no hay que copiar nada
+    for ( Arbol :: iter_preorden it = ab.begin() ; it != ab.end() ; ++it ) {
+        Tramo &t = ab.Etiqueta(it.GetNodo());
+        unsigned int inicio = nuevo.size();
+        nuevo.append(almacen, t.inicio, t.longitud);
+        t.inicio = inicio;
+    }
+
+    almacen.swap(nuevo);
+    muertos = 0;
+}
+
+
+size_t RefranesRadix :: FinPrefijo ( const string &cad ) const {
+
+    size_t pos = 0;
+
+    for ( int n = 0 ; n < len_prefijo ; n++ ) {
+        if ( pos >= cad.size() )
+            return string :: npos;
+        pos += Utf8 :: LongitudLetra(cad, pos);
+    }
+
+    return pos;
+}
+
+
+size_t RefranesRadix :: Comunes ( const Tramo &t, const string &cad, size_t desde ) const {
+
+    size_t i = 0;
+
+    // Se avanza por letras enteras: "e" y "e\u0301" no comparten nada. Como
+    // los bytes hasta i + l son iguales, la letra de la etiqueta solo puede
+    // ser mas larga si sigue con una marca diacritica
+    while ( desde + i < cad.size() ) {
+        size_t l = Utf8 :: LongitudLetra(cad, desde + i);
+
+        if ( i + l > t.longitud || almacen.compare(t.inicio + i, l, cad, desde + i, l) != 0 )
+            break;
+        if ( i + l < t.longitud && Utf8 :: LongitudLetra(almacen, t.inicio + i) != l )
+            break;
+
+        i += l;
+    }
+
+    return i;
+}
+
+
+int RefranesRadix :: ComparaLetra ( const Tramo &t, const string &cad, size_t desde ) const {
+
+    size_t lt = min((size_t)t.longitud, Utf8 :: LongitudLetra(almacen, t.inicio));
+    return almacen.compare(t.inicio, lt, cad, desde, Utf8 :: LongitudLetra(cad, desde));
+}
+
+
+RefranesRadix :: Arbol :: Nodo RefranesRadix :: Hijo ( Arbol :: Nodo padre, const string &cad, size_t desde, size_t fin, Arbol :: Nodo &anterior ) const {
+
+    anterior = 0;
+    Arbol :: Nodo h = ab.HijoMasIzquierda(padre);
+
+    // A profundidad len_prefijo los hijos son hojas y se compara el resto
+    // entero; antes, los hijos empiezan por letras distintas y basta la primera
+    bool hojas = desde == fin;
+
+    while ( h != 0 ) {
+        const Tramo &t = ab.Etiqueta(h);
+        int cmp;
+
+        if ( hojas )
+            cmp = almacen.compare(t.inicio, t.longitud, cad, desde, string :: npos);
+        else
+            cmp = ComparaLetra(t, cad, desde);
+
+        if ( cmp == 0 )
+            return h;
+        if ( cmp > 0 )
+            return 0;
+
+        anterior = h;
+        h = ab.HermanoDerecha(h);
+    }
+
+    return 0;
+}
+
+
+void RefranesRadix :: Cuelga ( Arbol :: Nodo padre, Arbol :: Nodo anterior, Arbol &rama ) {
+
+    if ( anterior == 0 )
+        ab.Insertar_hijoMasIzquierda(padre, std::move(rama));
+    else
+        ab.Insertar_hermanoDerecha(anterior, std::move(rama));
+}
+
+
+RefranesRadix :: Arbol :: Nodo RefranesRadix :: HermanoIzquierda ( Arbol :: Nodo n ) const {
+
+    Arbol :: Nodo h = ab.HijoMasIzquierda(ab.Padre(n));
+
+    if ( h == n )
+        return 0;
+
+    while ( ab.HermanoDerecha(h) != n )
+        h = ab.HermanoDerecha(h);
+
+    return h;
+}
+
+
+
+//-------------------------------------------------//
+//--------------FUNCIONES PUBLICAS-----------------//
+//-------------------------------------------------//
+
+RefranesRadix :: RefranesRadix ( int lpre ) {
+    Tramo vacio = { 0, 0 };
+    ab.AsignaRaiz(vacio);
+    len_prefijo = lpre;
+    n_ref = 0;
+    caracteres_totales = 0;
+    muertos = 0;
+}
+
+
+void RefranesRadix :: Insertar ( const string &refran ) {
+
+    size_t fin = FinPrefijo(refran);
+
+    if ( fin == string :: npos )
+        return;
+
+    if ( ab.Empty() ) {
+        Tramo vacio = { 0, 0 };
+        ab.AsignaRaiz(vacio);
+    }
+
+    Arbol :: Nodo padre = ab.Raiz();
+    size_t d = 0; // letras del refran que ya representan padre y sus antecesores
+
+    while ( true ) {
+        Arbol :: Nodo anterior;
+        Arbol :: Nodo h = Hijo(padre, refran, d, fin, anterior);
+
+        if ( d == fin && h != 0 ) // ya estaba
+            return;
+
+        if ( h == 0 ) { // ninguna rama comparte la siguiente letra
+            Arbol hoja(Guarda(refran, d));
+            Cuelga(padre, anterior, hoja);
+            break;
+        }
+
+        Tramo t = ab.Etiqueta(h);
+        bool es_hoja = ab.HijoMasIzquierda(h) == 0;
+        size_t comunes = Comunes(t, refran, d);
+
+        if ( !es_hoja && comunes == t.longitud ) { // se baja por la arista entera
+            padre = h;
+            d += comunes;
+            continue;
+        }
+
+        if ( es_hoja && comunes == t.longitud && comunes == refran.size() - d )
+            return; // ya estaba
+
+        // La arista se parte tras las letras comunes, pero nunca mas alla del
+        // prefijo: a partir de ahi el resto de la hoja no se comparte
+        size_t corte = es_hoja ? min(comunes, fin - d) : comunes;
+
+        Arbol :: Nodo hermano = HermanoIzquierda(h);
+        Arbol rama;
+        if ( hermano == 0 )
+            ab.Podar_hijoMasIzquierda(padre, rama);
+        else
+            ab.Podar_hermanoDerecha(hermano, rama);
+
+        Tramo cabeza = { t.inicio, (unsigned int)corte };
+        Tramo cola = { (unsigned int)(t.inicio + corte), (unsigned int)(t.longitud - corte) };
+        rama.Etiqueta(rama.Raiz()) = cola;
+
+        Arbol nuevo(cabeza);
+        Arbol hoja(Guarda(refran, d + corte));
+
+        // Los hijos se ordenan como los compara Hijo: por el resto entero si
+        // son hojas bajo el prefijo y, si no, por su primera letra
+        int cmp;
+        if ( d + corte == fin )
+            cmp = almacen.compare(cola.inicio, cola.longitud, refran, d + corte, string :: npos);
+        else
+            cmp = ComparaLetra(cola, refran, d + corte);
+
+        if ( cmp < 0 ) {
+            nuevo.Insertar_hijoMasIzquierda(nuevo.Raiz(), std::move(hoja));
+            nuevo.Insertar_hijoMasIzquierda(nuevo.Raiz(), std::move(rama));
+        }
+        else {
+            nuevo.Insertar_hijoMasIzquierda(nuevo.Raiz(), std::move(rama));
+            nuevo.Insertar_hijoMasIzquierda(nuevo.Raiz(), std::move(hoja));
+        }
+
+        Cuelga(padre, hermano, nuevo);
+        break;
+    }
+
+    n_ref++;
+    caracteres_totales += refran.size();
+}
+
+
+void RefranesRadix :: BorrarRefran ( const string &refran ) {
+
+    pair<bool, iterator> donde = Esta(refran);
+
+    if ( !donde.first )
+        return;
+
+    Arbol :: Nodo hoja = donde.second.it.GetNodo();
+    Arbol :: Nodo padre = ab.Padre(hoja);
+    Arbol :: Nodo hermano = HermanoIzquierda(hoja);
+    Arbol AlaHoguera;
+
+    muertos += ab.Etiqueta(hoja).longitud;
+
+    if ( hermano == 0 )
+        ab.Podar_hijoMasIzquierda(padre, AlaHoguera);
+    else
+        ab.Podar_hermanoDerecha(hermano, AlaHoguera);
+
+    n_ref--;
+    caracteres_totales -= refran.size();
+
+    // Si el padre se ha quedado con un solo hijo se une a el
+    Arbol :: Nodo unico = ab.HijoMasIzquierda(padre);
+    if ( padre != ab.Raiz() && ab.HermanoDerecha(unico) == 0 )
+        Une(padre, unico);
+
+    // Las etiquetas borradas se quedan en el almacen hasta que son la mitad
+    if ( muertos > almacen.size() / 2 )
+        Compacta();
+}
+
+
+void RefranesRadix :: Une ( Arbol :: Nodo padre, Arbol :: Nodo unico ) {
+
+    // Si las dos etiquetas estan seguidas en el almacen (el padre salio de
+    // partir la arista al insertar) la unida es el trozo que ocupan las dos
+    Tramo t = ab.Etiqueta(padre);
+    Tramo u = ab.Etiqueta(unico);
+    Tramo unida = { t.inicio, t.longitud + u.longitud };
+
+    if ( t.inicio + t.longitud != u.inicio ) {
+        unida = Guarda(almacen.substr(t.inicio, t.longitud) + almacen.substr(u.inicio, u.longitud), 0);
+        muertos += t.longitud + u.longitud;
+    }
+
+    Arbol rama;
+    ab.Podar_hijoMasIzquierda(padre, rama);
+    rama.Etiqueta(rama.Raiz()) = unida;
+
+    Arbol :: Nodo abuelo = ab.Padre(padre);
+    Arbol :: Nodo hermano = HermanoIzquierda(padre);
+    Arbol AlaHoguera;
+    if ( hermano == 0 )
+        ab.Podar_hijoMasIzquierda(abuelo, AlaHoguera);
+    else
+        ab.Podar_hermanoDerecha(hermano, AlaHoguera);
+
+    Cuelga(abuelo, hermano, rama);
+}
+
+
+pair<bool, RefranesRadix :: iterator> RefranesRadix :: Esta ( const string &refran ) {
+
+    pair<bool, iterator> aux(false, end());
+    size_t fin = FinPrefijo(refran);
+
+    if ( ab.Empty() || fin == string :: npos )
+        return aux;
+
+    Arbol :: Nodo padre = ab.Raiz();
+    size_t d = 0;
+
+    while ( true ) {
+        Arbol :: Nodo anterior;
+        Arbol :: Nodo h = Hijo(padre, refran, d, fin, anterior);
+
+        if ( h == 0 )
+            return aux;
+
+        const Tramo &t = ab.Etiqueta(h);
+        size_t comunes = Comunes(t, refran, d);
+
+        if ( ab.HijoMasIzquierda(h) == 0 ) { // hoja: tiene que ser el resto entero
+            if ( comunes != t.longitud || comunes != refran.size() - d )
+                return aux;
+
+            aux.first = true;
+            aux.second.it = ab.Posicion(h);
+            aux.second.almacen = &almacen;
+            aux.second.Situar();
+            return aux;
+        }
+
+        if ( comunes != t.longitud )
+            return aux;
+
+        padre = h;
+        d += comunes;
+    }
+}
+
+
+void RefranesRadix :: clear () {
+    ab.Clear();
+    almacen.clear();
+    muertos = 0;
+    n_ref = 0;
+    caracteres_totales = 0;
+}
+
+
+istream& operator>> ( istream &is, RefranesRadix &R ) {
+    return LeeRefranes(is, R);
+}
+
+
+ostream& operator<< ( ostream &os, RefranesRadix &R ) {
+
+    for ( RefranesRadix :: iterator it = R.begin() ; it != R.end() ; ++it )
+        os << (*it) << endl;
+
+    return os;
+}
+
+
+int RefranesRadix :: Caracteres_Refranes () const {
+    return caracteres_totales;
+}
+
+
+int RefranesRadix :: Caracteres_Almacenados () const {
+
+    int contador = 0;
+
+    Arbol :: const_iter_preorden it = ab.cbegin();
+    Arbol :: const_iter_preorden itF = ab.cend();
+
+    while ( it != itF ) { // la raiz tiene etiqueta vacia
+        contador += (*it).longitud;
+        ++it;
+    }
+
+    return contador;
+}
+
+
+int RefranesRadix :: Caracteres_Colas () const {
+
+    vector<string> etiquetas;
+
+    Arbol :: const_iter_preorden it = ab.cbegin();
+    Arbol :: const_iter_preorden itF = ab.cend();
+
+    if ( it != itF )
+        ++it; // para no contar la raiz
+    for ( ; it != itF ; ++it )
+        etiquetas.push_back(almacen.substr((*it).inicio, (*it).longitud));
+
+    AlmacenColas colas;
+    colas.Construye(etiquetas);
+
+    return colas.Caracteres();
+}
+
+
+UsoMemoria RefranesRadix :: MemoryUsage () const {
+
+    UsoMemoria u = ab.MemoryUsage();
+
+    size_t fuera = MemoriaExterna(almacen);
+    u.heap += fuera;
+    if ( fuera > 0 )
+        u.cadenas_heap++;
+
+    return u;
+}
+
+
+int RefranesRadix :: Numero_Nodos () const {
+    return ab.Size();
+}
+
+
+
+//-------------------------------------------------//
+//-------------------ITERADORES--------------------//
+//-------------------------------------------------//
+
+void RefranesRadix :: iterator :: Situar () {
+
+    prefijo.clear();
+    marca.assign(1, 0);
+
+    vector<Arbol :: Nodo> antecesores;
+    for ( Arbol :: Nodo n = it.GetNodo()->padre ; n != 0 ; n = n->padre )
+        antecesores.push_back(n);
+
+    for ( int i = (int)antecesores.size() - 1 ; i >= 0 ; i-- ) {
+        prefijo.append(*almacen, antecesores[i]->etiqueta.inicio, antecesores[i]->etiqueta.longitud);
+        marca.push_back(prefijo.size());
+    }
+}
+
+
+void RefranesRadix :: iterator :: Avanzar () {
+
+    // Igual que Avanzar en refranes.cpp, con las etiquetas en el almacen
+    do {
+        int nivel = it.getLevel();
+        Tramo etiqueta = *it;
+        ++it;
+
+        if ( it.GetNodo() == 0 ) {
+            prefijo.clear();
+            marca.assign(1, 0);
+            return;
+        }
+
+        if ( it.getLevel() > nivel ) {
+            prefijo.append(*almacen, etiqueta.inicio, etiqueta.longitud);
+            marca.push_back(prefijo.size());
+        }
+        else {
+            marca.resize(it.getLevel() + 2);
+            prefijo.resize(marca.back());
+        }
+    } while ( !it.Hoja() );
+}
+
+
+const string & RefranesRadix :: iterator :: operator* () {
+
+    if ( it.GetNodo() != 0 ) {
+        cad.assign(prefijo);
+        cad.append(*almacen, (*it).inicio, (*it).longitud);
+    }
+    return cad;
+}
+
+
+bool RefranesRadix :: iterator :: operator== ( const iterator &i ) const {
+    return it == i.it;
+}
+
+
+bool RefranesRadix :: iterator :: operator!= ( const iterator &i ) const {
+    return it != i.it;
+}
+
+
+RefranesRadix :: iterator & RefranesRadix :: iterator :: operator ++ () {
+
+    if ( it.GetNodo() != 0 )
+        Avanzar();
+
+    return *this;
+}
+
+
+RefranesRadix :: iterator RefranesRadix :: begin () {
+
+    if ( ab.Empty() || ab.HijoMasIzquierda(ab.Raiz()) == 0 )
+        return end();
+
+    iterator itb;
+    itb.it = ab.begin();
+    itb.almacen = &almacen;
+    itb.Avanzar();
+    return itb;
+}
+
+
+RefranesRadix :: iterator RefranesRadix :: end () {
+    iterator ite;
+    ite.it = ab.end();
+    ite.almacen = &almacen;
+    return ite;
+}
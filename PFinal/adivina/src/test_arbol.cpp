@@ -0,0 +1,854 @@
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <vector>
+#include <fstream>
+#include <cstdio>
+#include <queue>
+#include <iterator>
+#include "ArbolGeneral.h"
+#include "ArbolMapeado.h"
+
+using namespace std;
+
+
+/**
+ * @file test_arbol.cpp
+ * @author Gregorio Vidoy Fajardo y Jesus Ruiz Castellano
+ * @date 14 de Diciembre de 2016, 19:05
+ * @brief Fichero con las pruebas del TDA ArbolGeneral
+ */
+
+
+typedef ArbolGeneral<int> Arbol;
+typedef ArbolGeneral<int, AsignadorHeap, ConAnotaciones> ArbolAnotado;
+
+int fallos = 0; // Numero de comprobaciones fallidas
+
+
+/**
+ * @brief Anota un fallo si no se cumple la condicion
+ * @param cond : condicion a comprobar
+ * @param msg : descripcion de la comprobacion
+ */
+void Comprobar ( bool cond, const string &msg ) {
+
+  if ( !cond ) {
+    cout << " FALLO : " << msg << endl;
+    fallos++;
+  }
+}
+
+
+/**
+ * @brief Cuenta los nodos de un arbol recorriendolo entero
+ * @param ab : arbol a contar
+ * @return El numero de nodos de ab
+ */
+int Recuento ( const Arbol &ab ) {
+
+  int n = 0;
+
+  for ( Arbol :: const_iter_preorden it = ab.cbegin() ; it != ab.cend() ; ++it )
+    n++;
+
+  return n;
+}
+
+
+/**
+ * @brief Obtiene todos los nodos de un arbol en preorden
+ * @param ab : arbol del que se obtienen los nodos
+ * @return Vector con los nodos de ab
+ */
+vector<Arbol :: Nodo> Nodos ( Arbol &ab ) {
+
+  vector<Arbol :: Nodo> v;
+
+  for ( Arbol :: iter_preorden it = ab.begin() ; it != ab.end() ; ++it )
+    v.push_back(it.GetNodo());
+
+  return v;
+}
+
+
+/**
+ * @brief Construye un arbol aleatorio pequeño
+ * @param n : numero de nodos del arbol
+ */
+Arbol ArbolAleatorio ( int n ) {
+
+  Arbol ab(0);
+
+  for ( int i = 1 ; i < n ; i++ ) {
+    vector<Arbol :: Nodo> v = Nodos(ab);
+    Arbol hoja(i);
+    ab.Insertar_hijoMasIzquierda(v[rand() % v.size()], hoja);
+  }
+
+  return ab;
+}
+
+
+/**
+ * @brief Aplica secuencias aleatorias de operaciones que modifican el arbol
+ *        y comprueba tras cada una que Size() coincide con un recuento
+ */
+void TestContador () {
+
+  for ( int secuencia = 0 ; secuencia < 200 ; secuencia++ ) {
+
+    Arbol ab(0);
+
+    for ( int paso = 0 ; paso < 50 ; paso++ ) {
+
+      vector<Arbol :: Nodo> v = Nodos(ab);
+      Arbol otro;
+
+      switch ( v.empty() ? 0 : rand() % 8 ) {
+        case 0:
+          ab.AsignaRaiz(paso);
+          break;
+
+        case 1: {
+          Arbol rama = ArbolAleatorio(1 + rand() % 5);
+          ab.Insertar_hijoMasIzquierda(v[rand() % v.size()], rama);
+          Comprobar(rama.Size() == 0 && rama.Empty(), "rama vacia tras insertar");
+          break;
+        }
+
+        case 2: {
+          Arbol :: Nodo n = v[rand() % v.size()];
+          if ( ab.Padre(n) != 0 ) {
+            Arbol rama = ArbolAleatorio(1 + rand() % 5);
+            ab.Insertar_hermanoDerecha(n, rama);
+          }
+          break;
+        }
+
+        case 3:
+          ab.Podar_hijoMasIzquierda(v[rand() % v.size()], otro);
+          Comprobar(otro.Size() == Recuento(otro), "Size() de la rama podada");
+          break;
+
+        case 4:
+          ab.Podar_hermanoDerecha(v[rand() % v.size()], otro);
+          Comprobar(otro.Size() == Recuento(otro), "Size() de la rama podada");
+          break;
+
+        case 5:
+          otro.Asignar_subarbol(ab, v[rand() % v.size()]);
+          Comprobar(otro.Size() == Recuento(otro), "Size() tras Asignar_subarbol");
+          ab = otro;
+          break;
+
+        case 6: {
+          stringstream ss;
+          ss << ab;
+          ss >> otro;
+          Comprobar(otro.Size() == Recuento(otro), "Size() tras leer de un flujo");
+          break;
+        }
+
+        case 7:
+          if ( rand() % 4 == 0 )
+            ab.Clear();
+          break;
+      }
+
+      Comprobar(ab.Size() == Recuento(ab), "Size() coincide con el recuento");
+      Comprobar(ab.Empty() == (Recuento(ab) == 0), "Empty() coincide con el recuento");
+
+      Arbol copia(ab);
+      Comprobar(copia.Size() == ab.Size(), "Size() de la copia");
+    }
+  }
+}
+
+
+
+/**
+ * @brief Comprueba que las inserciones sin copia dejan el mismo arbol que
+ *        las inserciones con copia, y el movimiento entre arboles
+ */
+void TestMovimiento () {
+
+  for ( int prueba = 0 ; prueba < 100 ; prueba++ ) {
+
+    Arbol copiado(0), movido(0);
+
+    for ( int paso = 0 ; paso < 20 ; paso++ ) {
+      vector<Arbol :: Nodo> vc = Nodos(copiado);
+      vector<Arbol :: Nodo> vm = Nodos(movido);
+      int pos = rand() % vc.size();
+      Arbol rama = ArbolAleatorio(1 + rand() % 5);
+      Arbol rama2(rama);
+
+      if ( pos != 0 && rand() % 2 == 0 ) {
+        copiado.Insertar_hermanoDerecha(vc[pos], rama);
+        movido.Insertar_hermanoDerecha(vm[pos], std::move(rama2));
+      }
+      else {
+        copiado.Insertar_hijoMasIzquierda(vc[pos], rama);
+        movido.Insertar_hijoMasIzquierda(vm[pos], std::move(rama2));
+      }
+
+      Comprobar(rama2.Empty() && rama2.Size() == 0, "rama vacia tras insertar sin copia");
+      Comprobar(copiado == movido, "insertar con y sin copia dan el mismo arbol");
+      Comprobar(movido.Size() == Recuento(movido), "Size() tras insertar sin copia");
+
+      // Todos los nodos enlazados deben apuntar a su padre real
+      vm = Nodos(movido);
+      for ( size_t i = 0 ; i < vm.size() ; i++ )
+        for ( Arbol :: Nodo h = movido.HijoMasIzquierda(vm[i]) ; h != 0 ; h = movido.HermanoDerecha(h) )
+          Comprobar(movido.Padre(h) == vm[i], "padre correcto tras insertar sin copia");
+    }
+
+    Arbol destino(std::move(movido));
+    Comprobar(movido.Empty() && destino == copiado, "constructor de movimiento");
+
+    Arbol otro(1);
+    otro = std::move(destino);
+    Comprobar(destino.Empty() && otro == copiado, "asignacion por movimiento");
+    Comprobar(otro.Size() == copiado.Size(), "Size() tras mover");
+  }
+}
+
+
+
+/**
+ * @brief Copia, compara y destruye un arbol con muchos hermanos y otro muy
+ *        profundo. Con versiones recursivas desbordarian la pila.
+ */
+void TestArbolesGrandes () {
+
+  const int HERMANOS = 1000000;
+  const int PROFUNDIDAD = 100000;
+
+  Arbol ancho(0);
+  for ( int i = 1 ; i <= HERMANOS ; i++ )
+    ancho.Insertar_hijoMasIzquierda(ancho.Raiz(), Arbol(i));
+
+  Arbol profundo(0);
+  Arbol :: Nodo ultimo = profundo.Raiz();
+  for ( int i = 1 ; i <= PROFUNDIDAD ; i++ ) {
+    profundo.Insertar_hijoMasIzquierda(ultimo, Arbol(i));
+    ultimo = profundo.HijoMasIzquierda(ultimo);
+  }
+
+  Comprobar(ancho.Size() == HERMANOS + 1, "Size() del arbol ancho");
+  Comprobar(Recuento(profundo) == PROFUNDIDAD + 1, "recuento del arbol profundo");
+
+  Arbol copia_ancho(ancho);
+  Arbol copia_profundo;
+  copia_profundo = profundo;
+
+  Comprobar(copia_ancho == ancho, "copia del arbol ancho");
+  Comprobar(copia_profundo == profundo, "copia del arbol profundo");
+  Comprobar(Recuento(copia_ancho) == HERMANOS + 1, "recuento de la copia del arbol ancho");
+
+  // Cambiamos la etiqueta mas alejada de la raiz en cada copia
+  copia_profundo.Etiqueta(Nodos(copia_profundo).back()) = -1;
+  Comprobar(copia_profundo != profundo, "diferencia en el arbol profundo");
+
+  Arbol :: Nodo n = copia_ancho.HijoMasIzquierda(copia_ancho.Raiz());
+  while ( copia_ancho.HermanoDerecha(n) != 0 )
+    n = copia_ancho.HermanoDerecha(n);
+  copia_ancho.Etiqueta(n) = -1;
+  Comprobar(copia_ancho != ancho, "diferencia en el arbol ancho");
+
+  Arbol rama;
+  rama.Asignar_subarbol(profundo, profundo.HijoMasIzquierda(profundo.Raiz()));
+  Comprobar(rama.Size() == PROFUNDIDAD, "Asignar_subarbol del arbol profundo");
+
+  ancho.Clear();
+  Comprobar(ancho.Empty(), "Clear() del arbol ancho");
+  // El resto se destruye al salir de la funcion
+}
+
+
+
+/**
+ * @brief Comprueba que el arbol plano recorre los mismos nodos en el mismo
+ *        orden que el iterador en preorden, y el salto de subarboles
+ */
+void TestPlano () {
+
+  for ( int prueba = 0 ; prueba < 100 ; prueba++ ) {
+
+    Arbol ab = ArbolAleatorio(1 + rand() % 40);
+    ArbolPlano<int> plano = ab.freeze();
+
+    Comprobar(plano.Size() == ab.Size(), "Size() del arbol plano");
+
+    Arbol :: const_iter_preorden it = ab.cbegin();
+    ArbolPlano<int> :: const_iter_preorden ip = plano.cbegin();
+
+    for ( ; it != ab.cend() && ip != plano.cend() ; ++it, ++ip ) {
+      Comprobar(*it == *ip, "etiqueta del arbol plano");
+      Comprobar(it.getLevel() == ip.getLevel(), "nivel del arbol plano");
+      Comprobar(it.Hoja() == ip.Hoja(), "hoja del arbol plano");
+    }
+    Comprobar(it == ab.cend() && ip == plano.cend(), "fin del recorrido plano");
+
+    // Saltar un subarbol lleva al primer nodo posterior de nivel menor o igual
+    for ( int i = 0 ; i < plano.Size() ; i++ ) {
+      ArbolPlano<int> :: const_iter_preorden salto = plano.cbegin();
+      while ( salto.GetNodo() != i )
+        ++salto;
+      int nivel = salto.getLevel();
+      int esperado = i + 1;
+      while ( esperado < plano.Size() && plano.Nivel(esperado) > nivel )
+        esperado++;
+      salto.SkipSubtree();
+      Comprobar(salto.GetNodo() == esperado, "SkipSubtree del arbol plano");
+      if ( i > 0 )
+        Comprobar(plano.Nivel(plano.Padre(i)) == nivel - 1, "padre del arbol plano");
+    }
+  }
+}
+
+
+
+/**
+ * @brief Comprueba SkipSubtree y NextSibling de los iteradores en preorden
+ *        frente al recorrido completo
+ */
+void TestSaltos () {
+
+  for ( int prueba = 0 ; prueba < 100 ; prueba++ ) {
+
+    Arbol ab = ArbolAleatorio(1 + rand() % 60);
+    const Arbol &cab = ab;
+    vector<Arbol :: Nodo> v = Nodos(ab);
+    vector<int> niveles;
+    for ( Arbol :: iter_preorden it = ab.begin() ; it != ab.end() ; ++it )
+      niveles.push_back(it.getLevel());
+
+    for ( size_t i = 0 ; i < v.size() ; i++ ) {
+
+      // Primer nodo posterior que no es descendiente de v[i]
+      size_t fin = i + 1;
+      while ( fin < v.size() && niveles[fin] > niveles[i] )
+        fin++;
+
+      Arbol :: iter_preorden it = ab.begin();
+      while ( it.GetNodo() != v[i] )
+        ++it;
+      Arbol :: const_iter_preorden ci = it;
+
+      it.SkipSubtree();
+      ci.SkipSubtree();
+      if ( fin < v.size() ) {
+        Comprobar(it.GetNodo() == v[fin] && it.getLevel() == niveles[fin], "SkipSubtree");
+        Comprobar(ci.GetNodo() == v[fin] && ci.getLevel() == niveles[fin], "SkipSubtree constante");
+      }
+      else {
+        Comprobar(it == ab.end(), "SkipSubtree hasta el final");
+        Comprobar(ci == cab.cend(), "SkipSubtree constante hasta el final");
+      }
+
+      it = ab.begin();
+      while ( it.GetNodo() != v[i] )
+        ++it;
+      it.NextSibling();
+      if ( ab.HermanoDerecha(v[i]) != 0 )
+        Comprobar(it.GetNodo() == ab.HermanoDerecha(v[i]) && it.getLevel() == niveles[i], "NextSibling");
+      else
+        Comprobar(it.GetNodo() == 0, "NextSibling sin hermano");
+    }
+
+    // En el arbol plano NextSibling lleva al mismo hermano
+    ArbolPlano<int> plano = ab.freeze();
+    for ( int i = 0 ; i < plano.Size() ; i++ ) {
+      ArbolPlano<int> :: const_iter_preorden ip = plano.cbegin();
+      while ( ip.GetNodo() != i )
+        ++ip;
+      ip.NextSibling();
+      if ( ab.HermanoDerecha(v[i]) != 0 )
+        Comprobar(ip != plano.cend() && v[ip.GetNodo()] == ab.HermanoDerecha(v[i]), "NextSibling del arbol plano");
+      else
+        Comprobar(ip == plano.cend(), "NextSibling del arbol plano sin hermano");
+    }
+  }
+}
+
+
+
+/**
+ * @brief Comprueba que las anotaciones de todos los nodos coinciden con las
+ *        calculadas recorriendo el arbol
+ * @param ab : arbol a comprobar
+ * @param msg : operacion tras la que se comprueba
+ */
+void ComprobarAnotaciones ( const ArbolAnotado &ab, const string &msg ) {
+
+  vector<ArbolAnotado :: Nodo> v;
+  vector<int> niveles;
+  vector<ArbolAnotado :: Nodo> hojas;
+
+  for ( ArbolAnotado :: const_iter_preorden it = ab.cbegin() ; it != ab.cend() ; ++it ) {
+    v.push_back(it.GetNodo());
+    niveles.push_back(it.getLevel());
+    if ( it.Hoja() )
+      hojas.push_back(it.GetNodo());
+  }
+
+  for ( size_t i = 0 ; i < v.size() ; i++ ) {
+    int nhojas = 0;
+    size_t j = i;
+    do {
+      if ( ab.HijoMasIzquierda(v[j]) == 0 )
+        nhojas++;
+      j++;
+    } while ( j < v.size() && niveles[j] > niveles[i] );
+
+    Comprobar(ab.Profundidad(v[i]) == niveles[i] + 1, "profundidad " + msg);
+    Comprobar(ab.NumHojas(v[i]) == nhojas, "hojas del subarbol " + msg);
+  }
+
+  for ( size_t k = 0 ; k < hojas.size() ; k++ )
+    Comprobar(ab.HojaK(k) == hojas[k], "HojaK " + msg);
+}
+
+
+/**
+ * @brief Aplica secuencias aleatorias de operaciones a un arbol con
+ *        ConAnotaciones y comprueba las anotaciones tras cada una
+ */
+void TestAnotaciones () {
+
+  for ( int secuencia = 0 ; secuencia < 100 ; secuencia++ ) {
+
+    ArbolAnotado ab(0);
+
+    for ( int paso = 0 ; paso < 40 ; paso++ ) {
+
+      vector<ArbolAnotado :: Nodo> v;
+      for ( ArbolAnotado :: iter_preorden it = ab.begin() ; it != ab.end() ; ++it )
+        v.push_back(it.GetNodo());
+
+      ArbolAnotado rama(paso);
+      for ( int i = rand() % 4 ; i > 0 ; i-- ) {
+        ArbolAnotado :: Nodo r = rama.Raiz();
+        if ( rama.HijoMasIzquierda(r) != 0 && rand() % 2 )
+          r = rama.HijoMasIzquierda(r);
+        rama.Insertar_hijoMasIzquierda(r, ArbolAnotado(-i));
+      }
+      ComprobarAnotaciones(rama, "de la rama");
+
+      ArbolAnotado otro;
+      ArbolAnotado :: Nodo n = v.empty() ? 0 : v[rand() % v.size()];
+
+      switch ( v.empty() ? 0 : rand() % 8 ) {
+        case 0:
+          ab.AsignaRaiz(paso);
+          break;
+
+        case 1:
+          ab.Insertar_hijoMasIzquierda(n, rama);
+          break;
+
+        case 2:
+          ab.Insertar_hijoMasIzquierda(n, std::move(rama));
+          break;
+
+        case 3:
+          if ( ab.Padre(n) != 0 ) {
+            if ( rand() % 2 )
+              ab.Insertar_hermanoDerecha(n, rama);
+            else
+              ab.Insertar_hermanoDerecha(n, std::move(rama));
+          }
+          break;
+
+        case 4:
+          ab.Podar_hijoMasIzquierda(n, otro);
+          ComprobarAnotaciones(otro, "de la rama podada");
+          break;
+
+        case 5:
+          ab.Podar_hermanoDerecha(n, otro);
+          ComprobarAnotaciones(otro, "de la rama podada");
+          break;
+
+        case 6:
+          otro.Asignar_subarbol(ab, n);
+          ComprobarAnotaciones(otro, "tras Asignar_subarbol");
+          if ( rand() % 4 == 0 )
+            ab = otro;
+          break;
+
+        case 7: {
+          stringstream ss;
+          ss << ab;
+          ss >> otro;
+          ComprobarAnotaciones(otro, "tras leer de un flujo");
+          break;
+        }
+      }
+
+      ComprobarAnotaciones(ab, "tras modificar el arbol");
+      ArbolAnotado copia(ab);
+      ComprobarAnotaciones(copia, "de la copia");
+    }
+  }
+}
+
+
+
+/**
+ * @brief Poda ramas al azar, recicla sus nodos y los vuelve a insertar con
+ *        Rama, y comprueba que se reutilizan y que las anotaciones y el
+ *        tamaño siguen siendo correctos
+ */
+void TestReciclados () {
+
+  for ( int secuencia = 0 ; secuencia < 100 ; secuencia++ ) {
+
+    ArbolAnotado ab(0);
+    int reciclados = 0;
+
+    for ( int paso = 0 ; paso < 60 ; paso++ ) {
+
+      vector<ArbolAnotado :: Nodo> v;
+      for ( ArbolAnotado :: iter_preorden it = ab.begin() ; it != ab.end() ; ++it )
+        v.push_back(it.GetNodo());
+      ArbolAnotado :: Nodo n = v[rand() % v.size()];
+
+      if ( rand() % 3 == 0 ) {
+        ArbolAnotado otro;
+        if ( rand() % 2 )
+          ab.Podar_hijoMasIzquierda(n, otro);
+        else
+          ab.Podar_hermanoDerecha(n, otro);
+        reciclados += otro.Size();
+        ab.Reciclar(otro);
+        Comprobar(otro.Empty() && otro.Size() == 0, "rama vacia tras Reciclar");
+      }
+      else {
+        ArbolAnotado rama = ab.Rama(paso);
+        reciclados = max(reciclados - 1, 0);
+        Comprobar(rama.Size() == 1 && rama.Etiqueta(rama.Raiz()) == paso, "Rama de un nodo");
+        Comprobar(rama.HijoMasIzquierda(rama.Raiz()) == 0, "Rama sin hijos");
+        if ( ab.Padre(n) != 0 && rand() % 2 )
+          ab.Insertar_hermanoDerecha(n, std::move(rama));
+        else
+          ab.Insertar_hijoMasIzquierda(n, std::move(rama));
+      }
+
+      Comprobar(ab.Reciclados() == reciclados, "numero de reciclados");
+      ComprobarAnotaciones(ab, "tras reciclar");
+
+      int recuento = 0;
+      for ( ArbolAnotado :: const_iter_preorden it = ab.cbegin() ; it != ab.cend() ; ++it )
+        recuento++;
+      Comprobar(ab.Size() == recuento, "Size() tras reciclar");
+
+      // La holgura de MemoryUsage son los reciclados, del tamaño de un nodo
+      UsoMemoria mem = ab.MemoryUsage();
+      Comprobar(mem.holgura * ab.Size() == (mem.nodos + mem.en_linea) * (size_t)reciclados, "holgura de los reciclados");
+    }
+
+    // Los reciclados no se copian, se mueven con el arbol y Clear los libera
+    ArbolAnotado copia(ab);
+    Comprobar(copia.Reciclados() == 0 && copia == ab, "copia sin reciclados");
+    ArbolAnotado movido(std::move(ab));
+    Comprobar(movido.Reciclados() == reciclados && ab.Reciclados() == 0, "reciclados tras mover");
+    movido.Clear();
+    Comprobar(movido.Reciclados() == 0, "Clear libera los reciclados");
+  }
+
+  // Los huecos del pool son comunes a todos los arboles: no estan en el
+  // desglose de ninguno, sino en HolguraAsignador
+  typedef ArbolGeneral<int, AsignadorPool> ArbolPool;
+  ArbolPool a(1), b(2);
+  Comprobar(a.MemoryUsage().holgura == 0 && b.MemoryUsage().holgura == 0, "holgura del pool fuera del desglose");
+  Comprobar(ArbolPool :: HolguraAsignador() > 0, "HolguraAsignador del pool");
+  Comprobar(Arbol :: HolguraAsignador() == 0, "HolguraAsignador del heap");
+}
+
+
+
+/**
+ * @brief Copia y destruye arboles por encima del umbral de hilos con varios
+ *        numeros de hilos y comprueba que el resultado no cambia
+ */
+void TestHilos () {
+
+  int hilos = Arbol :: Hilos();
+
+  Arbol ab(0);
+  ArbolAnotado anotado(0);
+  for ( int i = 0 ; i < 30 ; i++ ) {
+    Arbol rama(i);
+    ArbolAnotado rama_anotada(i);
+    for ( int j = 0 ; j < 3000 ; j++ ) {
+      rama.Insertar_hijoMasIzquierda(rama.Raiz(), Arbol(j));
+      rama_anotada.Insertar_hijoMasIzquierda(rama_anotada.Raiz(), ArbolAnotado(j));
+    }
+    ab.Insertar_hijoMasIzquierda(ab.Raiz(), std::move(rama));
+    anotado.Insertar_hijoMasIzquierda(anotado.Raiz(), std::move(rama_anotada));
+  }
+
+  for ( int h = 1 ; h <= 8 ; h *= 2 ) {
+    Arbol :: Hilos(h);
+    ArbolAnotado :: Hilos(h);
+    Comprobar(Arbol :: Hilos() == h, "numero de hilos");
+
+    Arbol copia(ab);
+    Comprobar(copia == ab, "copia con varios hilos");
+    Comprobar(copia.Size() == ab.Size() && Recuento(copia) == ab.Size(), "Size() de la copia con varios hilos");
+
+    Arbol asignado(1);
+    asignado = copia;
+    Comprobar(asignado == ab, "asignacion con varios hilos");
+    copia.Clear();
+    Comprobar(copia.Empty() && copia.Size() == 0, "Clear con varios hilos");
+
+    ArbolAnotado copia_anotada(anotado);
+    Comprobar(copia_anotada == anotado, "copia anotada con varios hilos");
+    ArbolAnotado :: Nodo r = copia_anotada.Raiz();
+    Comprobar(copia_anotada.NumHojas(r) == 30 * 3000, "hojas de la copia con varios hilos");
+    Comprobar(copia_anotada.Profundidad(copia_anotada.HojaK(30 * 3000 - 1)) == 2, "profundidad en la copia con varios hilos");
+
+    // Con el pool los hilos no se usan, pero el resultado es el mismo
+    ArbolGeneral<int, AsignadorPool> pool(0);
+    for ( int i = 0 ; i < 60000 ; i++ )
+      pool.Insertar_hijoMasIzquierda(pool.Raiz(), ArbolGeneral<int, AsignadorPool>(i));
+    ArbolGeneral<int, AsignadorPool> :: Hilos(h);
+    ArbolGeneral<int, AsignadorPool> copia_pool(pool);
+    Comprobar(copia_pool == pool && copia_pool.Size() == pool.Size(), "copia con el pool y varios hilos");
+  }
+
+  Arbol :: Hilos(hilos);
+  ArbolAnotado :: Hilos(hilos);
+}
+
+
+
+/**
+ * @brief Anade a v los nodos del subarbol de n en postorden, con su nivel
+ */
+void Postorden ( Arbol &ab, Arbol :: Nodo n, int nivel, vector< pair<Arbol :: Nodo,int> > &v ) {
+
+  for ( Arbol :: Nodo h = ab.HijoMasIzquierda(n) ; h != 0 ; h = ab.HermanoDerecha(h) )
+    Postorden(ab, h, nivel + 1, v);
+  v.push_back(make_pair(n, nivel));
+}
+
+
+/**
+ * @brief Comprueba los recorridos en postorden y por niveles frente a 
+ *        recorridos de referencia (recursivo y con cola)
+ */
+void TestRecorridos () {
+
+  Arbol vacio;
+  Comprobar(vacio.begin_postorden() == vacio.end_postorden(), "postorden de un arbol vacio");
+  Comprobar(vacio.cbegin_nivel() == vacio.cend_nivel(), "niveles de un arbol vacio");
+
+  for ( int prueba = 0 ; prueba < 100 ; prueba++ ) {
+
+    Arbol ab = ArbolAleatorio(1 + rand() % 60);
+    const Arbol &cab = ab;
+
+    // Postorden
+    vector< pair<Arbol :: Nodo,int> > post;
+    Postorden(ab, ab.Raiz(), -1, post);
+
+    size_t i = 0;
+    Arbol :: iter_postorden it = ab.begin_postorden();
+    for ( ; it != ab.end_postorden() && i < post.size() ; ++it, ++i ) {
+      Comprobar(it.GetNodo() == post[i].first, "nodo en postorden");
+      Comprobar(it.getLevel() == post[i].second, "nivel en postorden");
+      Comprobar(*it == ab.Etiqueta(post[i].first), "etiqueta en postorden");
+    }
+    Comprobar(it == ab.end_postorden() && i == post.size(), "fin del postorden");
+
+    i = 0;
+    for ( Arbol :: const_iter_postorden ci = cab.cbegin_postorden() ; ci != cab.cend_postorden() ; ++ci, ++i )
+      Comprobar(i < post.size() && ci.GetNodo() == post[i].first, "postorden constante");
+    Comprobar(i == post.size(), "fin del postorden constante");
+
+    // Por niveles
+    vector< pair<Arbol :: Nodo,int> > anchura;
+    queue< pair<Arbol :: Nodo,int> > cola;
+    cola.push(make_pair(ab.Raiz(), -1));
+    while ( !cola.empty() ) {
+      pair<Arbol :: Nodo,int> x = cola.front();
+      cola.pop();
+      anchura.push_back(x);
+      for ( Arbol :: Nodo h = ab.HijoMasIzquierda(x.first) ; h != 0 ; h = ab.HermanoDerecha(h) )
+        cola.push(make_pair(h, x.second + 1));
+    }
+
+    i = 0;
+    Arbol :: iter_nivel in = ab.begin_nivel();
+    for ( ; in != ab.end_nivel() && i < anchura.size() ; ++in, ++i ) {
+      Comprobar(in.GetNodo() == anchura[i].first, "nodo por niveles");
+      Comprobar(in.getLevel() == anchura[i].second, "nivel por niveles");
+      Comprobar(in.Hoja() == (ab.HijoMasIzquierda(anchura[i].first) == 0), "hoja por niveles");
+    }
+    Comprobar(in == ab.end_nivel() && i == anchura.size(), "fin del recorrido por niveles");
+
+    i = 0;
+    for ( Arbol :: const_iter_nivel ci = cab.cbegin_nivel() ; ci != cab.cend_nivel() ; ++ci, ++i )
+      Comprobar(i < anchura.size() && ci.GetNodo() == anchura[i].first, "niveles constante");
+    Comprobar(i == anchura.size(), "fin del recorrido por niveles constante");
+  }
+
+  // Arboles degenerados: una cadena y una raiz con muchos hijos
+  Arbol cadena(0);
+  Arbol :: Nodo n = cadena.Raiz();
+  for ( int k = 1 ; k < 1000 ; k++ ) {
+    cadena.Insertar_hijoMasIzquierda(n, Arbol(k));
+    n = cadena.HijoMasIzquierda(n);
+  }
+  int esperado = 999;
+  for ( Arbol :: iter_postorden it = cadena.begin_postorden() ; it != cadena.end_postorden() ; ++it, --esperado )
+    Comprobar(*it == esperado && it.getLevel() == esperado - 1, "postorden de una cadena");
+  Comprobar(esperado == -1, "fin del postorden de una cadena");
+  esperado = 0;
+  for ( Arbol :: iter_nivel it = cadena.begin_nivel() ; it != cadena.end_nivel() ; ++it, ++esperado )
+    Comprobar(*it == esperado && it.getLevel() == esperado - 1, "niveles de una cadena");
+  Comprobar(esperado == 1000, "fin de los niveles de una cadena");
+}
+
+
+
+/**
+ * @brief Escribe y vuelve a leer arboles en el formato de texto y en el
+ *        formato binario
+ */
+void TestFormatos () {
+
+  for ( int prueba = 0 ; prueba < 50 ; prueba++ ) {
+
+    Arbol ab = ArbolAleatorio(1 + rand() % 40);
+
+    stringstream ss;
+    ss << ab;
+    Arbol leido;
+    ss >> leido;
+    Comprobar(leido == ab, "lectura del formato de texto");
+    Comprobar(leido.Size() == ab.Size(), "Size() tras leer el formato de texto");
+  }
+
+  // Etiquetas vacias y con separadores, que el formato de texto no admite
+  ArbolGeneral<string> ab("");
+  ab.Insertar_hijoMasIzquierda(ab.Raiz(), ArbolGeneral<string>("a caballo regalado"));
+  ab.Insertar_hijoMasIzquierda(ab.Raiz(), ArbolGeneral<string>("\n x "));
+  ab.Insertar_hijoMasIzquierda(ab.HijoMasIzquierda(ab.Raiz()), ArbolGeneral<string>(""));
+
+  const char *fichero = "test_arbol.bin";
+  {
+    ofstream fout ( fichero, ios::binary );
+    Comprobar(ArbolMapeado :: Escribir(fout, ab.freeze()), "escritura del formato binario");
+  }
+
+  Comprobar(ArbolMapeado :: EsBinario(fichero), "deteccion del formato binario");
+
+  ArbolMapeado mapa;
+  Comprobar(mapa.Abrir(fichero), "apertura del formato binario");
+  Comprobar(mapa.Size() == ab.Size(), "Size() del formato binario");
+
+  ArbolGeneral<string> leido;
+  mapa.Volcar(leido);
+  Comprobar(leido == ab, "lectura del formato binario");
+  Comprobar(leido.Size() == ab.Size(), "Size() tras leer el formato binario");
+
+  mapa.Cerrar();
+
+  // Ficheros dañados: Abrir los rechaza o, si la tabla sigue siendo la de un
+  // arbol, Volcar lo lee sin salirse de la proyeccion
+  ArbolGeneral<string> conEtiquetas("");
+  for ( int i = 0 ; i < 30 ; i++ )
+    conEtiquetas.Insertar_hijoMasIzquierda(conEtiquetas.Raiz(), ArbolGeneral<string>(string(1 + rand() % 20, 'a' + i % 26)));
+  {
+    ofstream fout ( fichero, ios::binary );
+    ArbolMapeado :: Escribir(fout, conEtiquetas.freeze());
+  }
+  string original;
+  {
+    ifstream fin ( fichero, ios::binary );
+    original.assign(istreambuf_iterator<char>(fin), istreambuf_iterator<char>());
+  }
+
+  const char *danado = "test_arbol_danado.bin";
+  typedef ArbolMapeado :: NodoBinario NodoBinario;
+  size_t cab = sizeof(ArbolMapeado :: CabeceraBinaria);
+  int n = conEtiquetas.Size();
+
+  for ( int prueba = 0 ; prueba < 500 ; prueba++ ) {
+    string bytes = original;
+    for ( int k = 0 ; k < 4 ; k++ )
+      bytes[cab + rand() % (bytes.size() - cab)] ^= 1 + rand() % 255;
+    {
+      ofstream fout ( danado, ios::binary );
+      fout.write(bytes.data(), bytes.size());
+    }
+    if ( mapa.Abrir(danado) ) {
+      ArbolGeneral<string> leido;
+      mapa.Volcar(leido);
+      Comprobar(leido.Size() == mapa.Size(), "lectura de un fichero dañado aceptado");
+      for ( int i = 0 ; i < mapa.Size() ; i++ )
+        Comprobar(mapa.Etiqueta(i).size() == (size_t)mapa.Longitud(i), "etiqueta de un fichero dañado aceptado");
+    }
+  }
+
+  // Cada campo de la tabla fuera de rango, uno a uno
+  for ( int campo = 0 ; campo < 6 ; campo++ ) {
+    string bytes = original;
+    NodoBinario *tabla = reinterpret_cast<NodoBinario*>(&bytes[cab]);
+    int i = 1 + rand() % (n - 1);
+    switch ( campo ) {
+      case 0: tabla[i].padre = n + 7; break;
+      case 1: tabla[i].padre = i; break;
+      case 2: tabla[i].inicio = 0xFFFFFFF0u; break;
+      case 3: tabla[i].longitud += bytes.size(); break;
+      case 4: tabla[i].fin = n + 1; break;
+      case 5: tabla[i].nivel += 3; break;
+    }
+    {
+      ofstream fout ( danado, ios::binary );
+      fout.write(bytes.data(), bytes.size());
+    }
+    Comprobar(!mapa.Abrir(danado), "rechazo de una tabla de nodos invalida");
+  }
+
+  // Y un fichero cortado a la mitad
+  {
+    ofstream fout ( danado, ios::binary );
+    fout.write(original.data(), original.size() / 2);
+  }
+  Comprobar(!mapa.Abrir(danado), "rechazo de un fichero incompleto");
+
+  remove(danado);
+  remove(fichero);
+}
+
+
+
+int main () {
+
+  srand(1);
+
+  TestContador();
+  TestMovimiento();
+  TestArbolesGrandes();
+  TestPlano();
+  TestRecorridos();
+  TestSaltos();
+  TestAnotaciones();
+  TestReciclados();
+  TestHilos();
+  TestFormatos();
+
+  if ( fallos == 0 )
+    cout << " test_arbol : OK" << endl;
+  else
+    cout << " test_arbol : " << fallos << " fallos" << endl;
+
+  return fallos == 0 ? 0 : 1;
+}
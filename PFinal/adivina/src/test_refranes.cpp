@@ -51,14 +51,21 @@ int main(int argc, char * argv[]){
   cout<<"Dime un secuencia a buscar en los refranes:";
   getline(cin,patron);
   patron=TodoMinuscula(patron);
-  Refranes::iterator it;
   cout<<endl;
-  for (it=refs.begin(); it!=refs.end();++it){
-    
-      size_t found = (*it).find(patron);
-      if (found!=string::npos)//si lo ha encontrado
-	cout<<*it<<endl;
-      
+  pair<bool, Refranes::iterator> b = refs.BuscaSubcadena(patron);
+  while (b.first){
+	cout<<*b.second<<endl;
+	b = refs.BuscaSubcadena(patron, ++b.second);
   }
+
+  // Autocompletado: los primeros refranes que empiezan por lo tecleado
+  string principio;
+  cout<<"Dime el principio de un refran:";
+  getline(cin,principio);
+  principio=TodoMinuscula(principio);
+  cout<<endl;
+  Refranes::Rango sugerencias = refs.ConPrefijo(principio, 10);
+  for (Refranes::Rango::iterator it = sugerencias.begin(); it != sugerencias.end(); ++it)
+	cout<<*it<<endl;
   
 }  
\ No newline at end of file
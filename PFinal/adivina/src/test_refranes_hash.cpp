@@ -35,6 +35,11 @@ int main(int argc, char * argv[]){
   cout << " Refranes leidos :" << endl;
   cout << refs << endl;
 
+  UsoMemoria mem = refs.MemoryUsage();
+  cout << " Memoria ocupada : " << mem.Total() << " bytes (cubetas " << mem.cubetas
+       << ", nodos " << mem.nodos << ", strings " << mem.en_linea << ", heap "
+       << mem.heap << " en " << mem.cadenas_heap << " refranes)" << endl;
+
   cout << "\n ESTAMOS EN TEST_REFRANES_HASH " << endl;
   
   cout << " Dime un Refran: ";